@@ -0,0 +1,104 @@
+// Circle vs wall narrowphase benchmark.
+// Usage: CollisionBench [queries]   (default: 200000)
+//
+// Scans every wall of mazes of growing size for random circles, once with
+// the scalar AoS loop (clamp, distance, branch per wall) and once with the
+// WallSoA kernel, checks both find the same walls and reports the speed-up.
+// Also times CollisionSystemMaze::GatherContacts, which picks between the
+// whole-maze scan and the grid.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "Gameplay/CollisionSystemMaze.h"
+#include "Gameplay/MazeGenerator.h"
+
+using namespace gameplay;
+using Clock = std::chrono::steady_clock;
+
+static double Seconds(Clock::time_point t0)
+{
+    return std::chrono::duration<double>(Clock::now() - t0).count();
+}
+
+static void ScanAoS(const std::vector<MazeWall>& walls, float cx, float cy, float r,
+                    std::vector<uint32_t>& out)
+{
+    out.clear();
+    for (uint32_t i = 0; i < uint32_t(walls.size()); ++i) {
+        const MazeWall& w = walls[i];
+        const float qx = std::clamp(cx, w.x, w.x + w.w);
+        const float qy = std::clamp(cy, w.y, w.y + w.h);
+        const float dx = cx - qx, dy = cy - qy;
+        if (dx*dx + dy*dy > r*r) continue;
+        out.push_back(i);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const size_t queries = size_t(std::max(1, argc > 1 ? std::atoi(argv[1]) : 200000));
+
+#if defined(__AVX2__)
+    std::printf("kernel: AVX2\n");
+#elif defined(__SSE2__) || defined(_M_X64)
+    std::printf("kernel: SSE2\n");
+#else
+    std::printf("kernel: scalar\n");
+#endif
+
+    const int sizes[][2] = { { 14, 10 }, { 28, 20 }, { 56, 40 }, { 112, 80 } };
+    for (const auto& sz : sizes) {
+        const int cols = sz[0], rows = sz[1];
+        const float cell = 40.f;
+
+        Maze maze;
+        MazeGenerator::Options opts;
+        opts.mergeWalls = true;
+        MazeGenerator::Generate(maze, cols, rows, 0.f, 8.f, cols * cell, rows * cell, 99u, opts);
+
+        std::mt19937 rng(7u);
+        std::uniform_real_distribution<float> xd(0.f, cols * cell), yd(0.f, rows * cell);
+        std::vector<float> qx(queries), qy(queries);
+        for (size_t i = 0; i < queries; ++i) { qx[i] = xd(rng); qy[i] = yd(rng); }
+        const float r = 12.f;
+
+        std::vector<uint32_t> a, b;
+        size_t hitsA = 0, hitsB = 0, mismatches = 0;
+
+        auto t0 = Clock::now();
+        for (size_t i = 0; i < queries; ++i) { ScanAoS(maze.walls, qx[i], qy[i], r, a); hitsA += a.size(); }
+        const double aos = Seconds(t0);
+
+        t0 = Clock::now();
+        for (size_t i = 0; i < queries; ++i) { maze.soa.Within(qx[i], qy[i], r, b); hitsB += b.size(); }
+        const double soa = Seconds(t0);
+
+        std::vector<WallContact> contacts;
+        size_t hitsC = 0;
+        t0 = Clock::now();
+        for (size_t i = 0; i < queries; ++i) {
+            CollisionSystemMaze::GatherContacts(maze, qx[i], qy[i], r, contacts);
+            hitsC += contacts.size();
+        }
+        const double gather = Seconds(t0);
+
+        for (size_t i = 0; i < queries; i += 97) {
+            ScanAoS(maze.walls, qx[i], qy[i], r, a);
+            maze.soa.Within(qx[i], qy[i], r, b);
+            if (a != b) ++mismatches;
+        }
+
+        std::printf("%4d x %-3d %5zu walls   AoS %7.1f ns   SoA %7.1f ns  x%.1f   GatherContacts %7.1f ns   %s\n",
+                    cols, rows, maze.walls.size(),
+                    aos / double(queries) * 1e9, soa / double(queries) * 1e9, aos / soa,
+                    gather / double(queries) * 1e9,
+                    (mismatches == 0 && hitsA == hitsB && hitsC <= hitsA) ? "match" : "MISMATCH");
+        if (mismatches || hitsA != hitsB) return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,165 @@
+// Maze generation benchmark.
+// Usage: MazeGenBench [side ...]   (default: 100 1000 4000 10000)
+//
+// Times PackedMaze::Generate on side x side grids, checks the result is a
+// perfect maze (cells-1 passages, every cell reachable) and reports memory
+// held. The region-parallel path runs on a JobSystem with every core, and
+// small sizes are also run through MazeGenerator for comparison, and a
+// MazeCache round trip shows what loading a known level costs instead.
+// Last, a MazeStream stacks Eller bands and the stack gets the same perfect
+// maze check, so the band seams are covered too.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "Gameplay/JobSystem.h"
+#include "Gameplay/MazeCache.h"
+#include "Gameplay/MazeGenerator.h"
+#include "Gameplay/MazeStream.h"
+#include "Gameplay/PackedMaze.h"
+
+using namespace gameplay;
+using Clock = std::chrono::steady_clock;
+
+static double Seconds(Clock::time_point t0)
+{
+    return std::chrono::duration<double>(Clock::now() - t0).count();
+}
+
+// Streams 'bands' bands in one go, stacks their cell walls into one grid
+// and checks it is a single perfect maze whose seams agree from both sides.
+// Then scrolls a small ring far away and back and checks a band comes back
+// identical.
+static bool StreamPass(int cols, int bandRows, int bands)
+{
+    MazeGenerator::BandParams p;
+    p.cols = cols; p.bandRows = bandRows;
+    p.cellW = p.cellH = 16.f; p.wallThickness = 4.f;
+    p.seed = 12345u;
+    const float bandH = float(bandRows) * p.cellH;
+
+    MazeStream stream;
+    stream.Reset(p, bands);
+    auto t0 = Clock::now();
+    const int generated = stream.Update(0.f, bands * bandH - 1.f);
+    const double gen = Seconds(t0);
+
+    const size_t bandCells = size_t(cols) * size_t(bandRows);
+    std::vector<uint8_t> stacked(bandCells * size_t(bands));
+    size_t seamMismatch = 0;
+    for (int b = 0; b < bands; ++b) {
+        const Maze* m = stream.Band(b);
+        if (!m || m->cellWalls.size() != bandCells) {
+            std::printf("stream: band %d missing\n", b);
+            return false;
+        }
+        std::copy(m->cellWalls.begin(), m->cellWalls.end(), stacked.begin() + bandCells * size_t(b));
+        if (b == 0) continue;
+        // north of band b-1's top row against south of band b's first row
+        const uint8_t* below = &stacked[bandCells * size_t(b) - size_t(cols)];
+        const uint8_t* above = &stacked[bandCells * size_t(b)];
+        for (int c = 0; c < cols; ++c)
+            if (bool(below[c] & 1u) != bool(above[c] & 4u)) ++seamMismatch;
+    }
+
+    PackedMaze packed;
+    packed.Assign(cols, bandRows * bands, stacked.data());
+    const size_t cells = bandCells * size_t(bands);
+    const size_t passages = packed.CountPassages();
+    const size_t reached = packed.CountReachable();
+    const bool perfect = passages == cells - 1 && reached == cells && seamMismatch == 0;
+
+    // regenerate band 3 after the ring scrolled far past it
+    MazeStream ring;
+    ring.Reset(p, 4);
+    ring.Update(1000.f * bandH, 1001.f * bandH);
+    ring.Update(3.f * bandH, 3.5f * bandH);
+    const Maze* again = ring.Band(3);
+    const bool replay = again && bands > 3 &&
+        std::equal(again->cellWalls.begin(), again->cellWalls.end(), stacked.begin() + bandCells * 3);
+
+    std::printf("stream %d bands of %d x %d  %8.1f ms  %zu/%zu passages, %zu/%zu reached, "
+                "%zu seam mismatches, replay %s  %s\n",
+                generated, cols, bandRows, gen * 1e3, passages, cells - 1, reached, cells,
+                seamMismatch, replay ? "same" : "DIFFERENT",
+                perfect && replay ? "perfect" : "NOT PERFECT");
+    return perfect && replay;
+}
+
+int main(int argc, char** argv)
+{
+    std::vector<int> sides;
+    for (int i = 1; i < argc; ++i) sides.push_back(std::atoi(argv[i]));
+    if (sides.empty()) sides = { 100, 1000, 4000, 10000 };
+
+    JobSystem jobs;
+    PackedMaze packed;
+    for (int side : sides) {
+        if (side < 2) continue;
+        const double cells = double(side) * double(side);
+
+        auto t0 = Clock::now();
+        packed.Generate(side, side, 12345u);
+        const double first = Seconds(t0);
+
+        // second run at the same size reuses every buffer
+        t0 = Clock::now();
+        packed.Generate(side, side, 54321u);
+        const double reuse = Seconds(t0);
+
+        const bool perfect = packed.IsPerfect();
+
+        std::printf("packed %5d x %-5d  %8.1f ms  (reuse %8.1f ms)  %7.1f Mcells/s  %8.1f MiB  %s\n",
+                    side, side, first * 1e3, reuse * 1e3, cells / reuse * 1e-6,
+                    double(packed.MemoryBytes()) / (1024.0 * 1024.0),
+                    perfect ? "perfect" : "NOT PERFECT");
+        if (!perfect) return 1;
+
+        t0 = Clock::now();
+        packed.GenerateParallel(side, side, 12345u, 256, &jobs);
+        const double par = Seconds(t0);
+        const bool parPerfect = packed.IsPerfect();
+        std::printf("  regions 256^2      %8.1f ms  %7.1f Mcells/s  x%.2f on %d threads  %s\n",
+                    par * 1e3, cells / par * 1e-6, reuse / par, jobs.WorkerCount() + 1,
+                    parPerfect ? "perfect" : "NOT PERFECT");
+        if (!parPerfect) return 1;
+
+        // the rectangle path emits ~2 walls per cell, keep it to small grids
+        if (side <= 1000) {
+            Maze maze;
+            for (int mode = 0; mode < 2; ++mode) {
+                MazeGenerator::Options opts;
+                opts.packed = mode == 1;
+                t0 = Clock::now();
+                MazeGenerator::Generate(maze, side, side, 0.f, 1.f,
+                                        float(side), float(side), 12345u, opts);
+                std::printf("  MazeGenerator (%s)  %8.1f ms  %zu walls\n",
+                            opts.packed ? "packed" : "cells ", Seconds(t0) * 1e3, maze.walls.size());
+            }
+
+            // full level options: merged walls, flow field, SDF
+            MazeCache cache("mazecache_bench");
+            MazeKey key;
+            key.cols = side; key.rows = side;
+            key.margin = 0.f; key.wallThickness = 4.f;
+            key.width = 16.f * side; key.height = 16.f * side;
+            key.seed = 12345u;
+            key.mergeWalls = true; key.flowToEnd = true; key.sdfCellSize = 8.f;
+
+            std::remove(cache.PathFor(key).c_str());
+            t0 = Clock::now();
+            cache.LoadOrGenerate(key, maze);
+            const double gen = Seconds(t0);
+            t0 = Clock::now();
+            const bool hit = cache.Load(key, maze);
+            std::printf("  MazeCache          %8.1f ms generate+store, %8.1f ms load  %s\n",
+                        gen * 1e3, Seconds(t0) * 1e3, hit ? "hit" : "MISS");
+        }
+    }
+
+    if (!StreamPass(64, 16, 64)) return 1;
+    return 0;
+}
@@ -0,0 +1,96 @@
+// Collectible placement benchmark.
+// Usage: PlacementBench [count ...]   (default: 10 100 1000 5000)
+//
+// Places 'count' collectibles on one large maze with the free-cell Poisson
+// sampler (LevelBuilder::PlaceCollectibles) and with the old rejection path
+// (PlaceCollectiblesRejection), then checks every result for wall overlaps
+// and counts pairs closer than the requested spacing.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "Gameplay/CollisionSystemMaze.h"
+#include "Gameplay/LevelBuilder.h"
+#include "Gameplay/MazeGenerator.h"
+
+using namespace gameplay;
+using Clock = std::chrono::steady_clock;
+
+static double Seconds(Clock::time_point t0)
+{
+    return std::chrono::duration<double>(Clock::now() - t0).count();
+}
+
+struct Check { int wallHits = 0; int closePairs = 0; };
+
+static Check Validate(const Maze& maze, const LevelParams& p, const std::vector<ThreeBlade>& pts)
+{
+    Check c;
+    const float r = p.collectibleRadius;
+    const float sep = 2.f * r + 8.f;
+    for (const auto& P : pts)
+        if (CollisionSystemMaze::CircleOverlapsAnyWall(maze, P[0], P[1], r)) ++c.wallHits;
+
+    // sort by x so the pair count stays cheap for large n
+    std::vector<ThreeBlade> s(pts);
+    std::sort(s.begin(), s.end(), [](const ThreeBlade& a, const ThreeBlade& b) { return a[0] < b[0]; });
+    for (size_t i = 0; i < s.size(); ++i) {
+        for (size_t j = i + 1; j < s.size() && s[j][0] - s[i][0] < sep; ++j) {
+            const float dx = s[j][0] - s[i][0], dy = s[j][1] - s[i][1];
+            if (dx*dx + dy*dy < sep * sep) ++c.closePairs;
+        }
+    }
+    return c;
+}
+
+int main(int argc, char** argv)
+{
+    std::vector<int> counts;
+    for (int i = 1; i < argc; ++i) counts.push_back(std::atoi(argv[i]));
+    if (counts.empty()) counts = { 10, 100, 1000, 5000 };
+
+    // 200 x 120 cells of 48 px: room for ~one collectible per cell
+    LevelParams p;
+    p.cols = 200; p.rows = 120;
+    p.mazeMargin = 80.f;
+    p.wallThickness = 12.f;
+    p.width  = 2.f * p.mazeMargin + p.cols * 48.f;
+    p.height = 2.f * p.mazeMargin + p.rows * 48.f;
+
+    Maze maze;
+    MazeGenerator::Options opts;
+    opts.mergeWalls  = p.mergeWalls;
+    opts.sdfCellSize = p.sdfCellSize;
+    MazeGenerator::Generate(maze, p.cols, p.rows, p.mazeMargin, p.wallThickness,
+                            p.width, p.height, 777u, opts);
+    std::printf("maze %d x %d, %zu walls\n", p.cols, p.rows, maze.walls.size());
+
+    std::vector<ThreeBlade> out;
+    for (int n : counts) {
+        if (n <= 0) continue;
+
+        std::mt19937 rng(1234u);
+        auto t0 = Clock::now();
+        LevelBuilder::PlaceCollectibles(rng, p, maze, n, out);
+        const double fast = Seconds(t0);
+        const size_t placed = out.size();
+        const Check cf = Validate(maze, p, out);
+
+        rng.seed(1234u);
+        t0 = Clock::now();
+        LevelBuilder::PlaceCollectiblesRejection(rng, p, maze, n, out);
+        const double slow = Seconds(t0);
+        const Check cs = Validate(maze, p, out);
+
+        std::printf("%6d  free-cell %9.3f ms (%zu placed, %d wall hits, %d close pairs)   "
+                    "rejection %9.3f ms (%d wall hits, %d close pairs)   x%.1f\n",
+                    n, fast * 1e3, placed, cf.wallHits, cf.closePairs,
+                    slow * 1e3, cs.wallHits, cs.closePairs, slow / std::max(fast, 1e-9));
+        if (cf.wallHits) return 1;
+    }
+    return 0;
+}
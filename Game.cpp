@@ -4,6 +4,7 @@
 #include <cmath>
 #include <chrono>
 #include <random>
+#include <thread>
 #include <SDL.h>
 #include <SDL_opengl.h>
 #include <SDL_ttf.h>
@@ -15,11 +16,13 @@
 #include "gameplay/PlayerController.h"
 #include "gameplay/CollisionSystem.h"
 #include "Gameplay/CollisionSystemMaze.h"
+#include "Gameplay/MazeQuery.h"
 #include "gameplay/PillarRenderer.h"
 #include "gameplay/PlayerRenderer.h"
 #include "gameplay/HUDRenderer.h"
 #include "Gameplay/MazeGenerator.h"
 #include "Gameplay/MazeRenderer.h"
+#include "Gameplay/AgentRenderer.h"
 
 using namespace utils;
 
@@ -35,50 +38,38 @@ static gameplay::PillarType ToPillarType(const gameplay::MovablePillar& mp) {
     }
 }
 
-// PGA point distance
-static inline float DistPGA(const ThreeBlade& A, const ThreeBlade& B)
-{
-    TwoBlade L = A & B;
-    return L.Norm();
-}
-
 }
 
-Game::Game(const Window& window)
+Game::Game(const Window& window, uint32_t seed)
     : m_Window{window}
 {
     m_Viewport = SDL_Rect{0, 0, int(window.width), int(window.height)};
 
-    std::random_device rd;
-    m_Rng.seed(rd());
+    // only a replayable run is worth keeping mazes on disk for
+    const bool replay = seed != 0;
+    if (seed == 0) {
+        std::random_device rd;
+        seed = rd();
+    }
+    m_Rng.seed(seed);
+    std::cout << "Game seed " << seed << "\n";
 
     InitializeGameEngine();
 
-    m_MaxElapsedSeconds = 1.f / 60.f;
+    m_MaxElapsedSeconds = 1.f / 30.f;
 
     m_Character = ThreeBlade{ m_Window.width / 2.f, m_Window.height / 2.f, 0.f, 1.f };
 
-    gameplay::MazeGenerator::Generate(
-        m_Maze, 14, 10, 80.f, 20.f,
-        m_Window.width, m_Window.height, 0);
+    m_LevelParams.width  = m_Window.width;
+    m_LevelParams.height = m_Window.height;
+    if (replay)
+        m_LevelParams.mazeCache = &m_MazeCache;
 
-    m_Character = m_Maze.startCenter;
-    m_Vx = m_Vy = 0.f;
-    m_VzEnergy = 0.f;
+    // first level is built here, the following ones in the background
+    LoadLevel(gameplay::LevelBuilder::Build(m_LevelParams, NextLevelSeed()));
     m_Maze.endRadius = 22.f;
 
-    SpawnRandomPillars(2, 80.f);
-
-    SpawnCollectibles(2, 5, 60.f);
-
-    // pick an initial active pillar if any
-    int total = int(m_PillarArray.size() + m_Movable.size() + m_Reflectors.size());
-    if (total > 0) {
-        std::uniform_int_distribution<int> pick(0, total - 1);
-        m_CurrentPillarIndex = pick(m_Rng);
-    } else {
-        m_CurrentPillarIndex = -1;
-    }
+    m_LevelPipeline.Start(m_LevelParams, NextLevelSeed());
 }
 
 Game::~Game()
@@ -170,6 +161,12 @@ void Game::Run()
         return;
     }
 
+    // the render thread owns the GL context from here on
+    PublishSnapshot();
+    SDL_GL_MakeCurrent(m_pWindow.get(), nullptr);
+    m_RenderQuit = false;
+    std::thread renderThread([this] { RenderLoop(); });
+
     bool quit{ false };
     auto t1 = std::chrono::steady_clock::now();
 
@@ -198,10 +195,96 @@ void Game::Run()
             dt = std::min(dt, m_MaxElapsedSeconds);
 
             Update(dt);
-            Draw();
-            SDL_GL_SwapWindow(m_pWindow.get());
+            PublishSnapshot();
+
+            // sim runs on its own tick, swap-interval blocking happens elsewhere
+            std::this_thread::sleep_until(t2 + std::chrono::duration<float>(m_SimTickSeconds));
         }
     }
+
+    m_RenderQuit = true;
+    renderThread.join();
+    SDL_GL_MakeCurrent(m_pWindow.get(), m_pContext.get());
+}
+
+void Game::RenderLoop()
+{
+    if (SDL_GL_MakeCurrent(m_pWindow.get(), m_pContext.get()) != 0)
+    {
+        std::cerr << "Game::RenderLoop(), SDL_GL_MakeCurrent: " << SDL_GetError() << std::endl;
+        return;
+    }
+
+    bool haveFrame = false;
+    while (!m_RenderQuit)
+    {
+        const bool fresh = m_Snapshots.Acquire();
+        haveFrame |= fresh;
+
+        // without vsync there is nothing to pace us, so don't redraw stale frames
+        if (!fresh && !m_Window.isVSyncOn) { std::this_thread::yield(); continue; }
+
+        if (haveFrame) Draw(m_Snapshots.ReadSlot());
+        SDL_GL_SwapWindow(m_pWindow.get());
+    }
+
+    SDL_GL_MakeCurrent(m_pWindow.get(), nullptr);
+}
+
+void Game::PublishSnapshot()
+{
+    gameplay::FrameSnapshot& s = m_Snapshots.WriteSlot();
+    s.frameIndex = ++m_SimFrame;
+    s.cameraX = m_WorldMode ? m_CameraX : 0.f;
+    s.cameraY = m_WorldMode ? m_CameraY : 0.f;
+
+    s.character       = m_Character;
+    s.characterRadius = m_CharacterRadius;
+    s.vx = m_Vx; s.vy = m_Vy; s.vzEnergy = m_VzEnergy;
+
+    s.chunkMazes.clear();
+    if (m_WorldMode) {
+        // only the active tiles reach the renderer
+        s.pillars.assign(m_WorldPillars.begin(), m_WorldPillars.end());
+        s.maze.reset();
+        s.mazeGeneration = 0;
+        s.endInSight = false;
+        for (int slot : m_World.Active()) s.chunkMazes.push_back(m_World.Chunk(slot).maze);
+        s.collectibleField.reset();
+        m_World.GatherCollectibles(s.collectibles, s.collected);
+        s.fishX.clear(); s.fishY.clear(); s.fishEnergy.clear();
+    } else {
+        s.pillars.clear();
+        s.pillars.insert(s.pillars.end(), m_PillarArray.begin(), m_PillarArray.end());
+        for (const auto& mp : m_Movable)    s.pillars.emplace_back(mp.C, ToPillarType(mp));
+        for (const auto& rp : m_Reflectors) s.pillars.emplace_back(rp.Center(), gameplay::PillarType::Reflect);
+
+        if (!m_PublishedMaze || m_PublishedMaze->generation != m_Maze.generation)
+            m_PublishedMaze = std::make_shared<const gameplay::Maze>(m_Maze);
+        s.maze = m_PublishedMaze;
+        s.mazeGeneration = m_Maze.generation;
+        s.endInSight = gameplay::MazeQuery::LineOfSight(m_Maze, m_Character, m_Maze.endCenter);
+
+        if (!m_PublishedCollectibles || m_PublishedCollectibles->version != m_CollectibleField.version)
+            m_PublishedCollectibles = std::make_shared<const gameplay::CollectibleField>(m_CollectibleField);
+        s.collectibleField = m_PublishedCollectibles;
+        s.collectibles.clear();
+        s.collected.clear();
+
+        s.fishX.assign(m_Fish.x.begin(), m_Fish.x.end());
+        s.fishY.assign(m_Fish.y.begin(), m_Fish.y.end());
+        s.fishEnergy.assign(m_Fish.energy.begin(), m_Fish.energy.end());
+    }
+    s.active = s.pillars.empty() ? -1
+             : std::clamp(m_CurrentPillarIndex, 0, int(s.pillars.size()) - 1);
+    s.collectibleRadius = m_WorldMode ? m_WorldParams.collectibleRadius : m_CollectibleRadius;
+
+    s.fishRadius = m_Fish.radius;
+
+    s.maxSpeed = m_MaxSpeed;
+    s.collectiblesRemaining = int(m_CollectibleField.Remaining());
+
+    m_Snapshots.Publish();
 }
 
 // input
@@ -265,6 +348,24 @@ void Game::ProcessKeyDownEvent(const SDL_KeyboardEvent& e)
     case SDL_SCANCODE_RETURN:
         GEOAClone();
         break;
+    case SDL_SCANCODE_N:
+        // restart on a fresh level, usually already built in the background
+        std::cout << "Next level (" << m_LevelPipeline.ReadyCount() << " ready)\n";
+        NextLevel();
+        break;
+    case SDL_SCANCODE_I:
+        // toggle the endless world; leaving it starts a fresh level
+        if (m_WorldMode) NextLevel();
+        else EnterWorldMode();
+        break;
+    case SDL_SCANCODE_F3:
+        m_ShowSolverStats = !m_ShowSolverStats;
+        std::cout << "Solver stats " << (m_ShowSolverStats ? "on" : "off") << "\n";
+        break;
+    case SDL_SCANCODE_F:
+        SpawnFish(m_FishSpawnCount);
+        std::cout << "Fish school: " << m_Fish.Size() << " agents\n";
+        break;
     default: break;
     }
 }
@@ -290,20 +391,40 @@ void Game::ProcessKeyUpEvent(const SDL_KeyboardEvent& e)
 // update / draw
 void Game::Update(float dt)
 {
+    UpdateSeekFlow();
     Integrate(dt);
-    HandleWallCollisions();
+
+    // the world has no outer bounds, the camera follows instead
+    if (m_WorldMode) UpdateCamera(dt);
+    else HandleWallCollisions();
 }
 
-void Game::Draw() const
+void Game::Draw(const gameplay::FrameSnapshot& snap) const
 {
     glClearColor(0.05f, 0.06f, 0.1f, 1.0f);
     glClear(GL_COLOR_BUFFER_BIT);
 
-    gameplay::MazeRenderer::Draw(m_Maze);
-    DrawPillars();
-    DrawCollectibles();
-    DrawCharacter();
-    DrawHUD();
+    ApplyCamera(snap.cameraX, snap.cameraY);
+
+    if (snap.maze) gameplay::MazeRenderer::Draw(*snap.maze, snap.endInSight);
+    for (const auto& m : snap.chunkMazes) gameplay::MazeRenderer::DrawWalls(*m);
+    DrawPillars(snap);
+    DrawCollectibles(snap);
+    DrawFish(snap);
+    DrawCharacter(snap);
+
+    // HUD stays in screen space
+    ApplyCamera(0.f, 0.f);
+    DrawHUD(snap);
+}
+
+// bottom-left origin, y-up, scrolled so (x,y) is the lower-left corner
+void Game::ApplyCamera(float x, float y) const
+{
+    glMatrixMode(GL_PROJECTION);
+    glLoadIdentity();
+    glOrtho(x, x + m_Window.width, y, y + m_Window.height, -1, 1);
+    glMatrixMode(GL_MODELVIEW);
 }
 
 // pick a spawn that is far enough from the pillars' influence
@@ -367,30 +488,110 @@ void Game::SpawnOutsideInfluence(float minClearance)
 }
 
 // gameplay delegation
+// One frame as a task graph:
+//   player pre-pass (walls, reflectors) and mover stepping run side by side,
+//   player kinematics and the fish crowd both wait for the gathered pillars,
+//   pickups / end gate run last since they may swap the whole level.
 void Game::Integrate(float dt)
 {
+    m_FrameGraph.Clear();
+
+    auto pre     = m_FrameGraph.Add([this]     { IntegratePlayerPre(); });
+    auto movers  = m_FrameGraph.Add([this, dt] { StepMovers(dt); });
+    auto gather  = m_FrameGraph.Add([this, dt] { GatherPillars(dt); });
+    auto player  = m_FrameGraph.Add([this, dt] { IntegratePlayer(dt); });
+    auto fish    = m_FrameGraph.Add([this, dt] { StepFish(dt); });
+    auto pickups = m_FrameGraph.Add([this]     { CheckPickups(); });
+
+    m_FrameGraph.Precede(movers, gather);
+    m_FrameGraph.Precede(pre,    player);
+    m_FrameGraph.Precede(gather, player);
+    m_FrameGraph.Precede(gather, fish);
+    m_FrameGraph.Precede(player, pickups);
+    m_FrameGraph.Precede(fish,   pickups);
+
+    m_Jobs.Run(m_FrameGraph);
+
+    ReportStats(dt);
+}
+
+void Game::IntegratePlayerPre()
+{
+    ResolvePlayer();
+}
+
+void Game::ResolvePlayer()
+{
+    if (m_WorldMode) {
+        m_World.Resolve(m_Character, m_Vx, m_Vy, m_CharacterRadius, m_BounceLoss);
+        return;
+    }
+
     gameplay::CollisionSystemMaze::Resolve(
-        m_Maze, m_Character, m_Vx, m_Vy, m_CharacterRadius, m_BounceLoss);
+        m_Maze, m_Character, m_Vx, m_Vy, m_CharacterRadius, m_BounceLoss, &m_PlayerContacts);
 
-    bool reflected = false;
-    for (auto& rp : m_Reflectors)
-        reflected |= rp.TryReflect(m_Character, m_Vx, m_Vy, dt);
+    // triggers are diffed once per substep, after the move (StepPlayer)
+    if (m_TriggersDirty) RebuildTriggers();
+}
 
-    if (reflected) {
-        gameplay::CollisionSystemMaze::DepenetratePosition(
-            m_Maze, m_Character, m_CharacterRadius, 16, 0.75f);
+void Game::StepMovers(float dt)
+{
+    if (m_WorldMode) {
+        m_World.StepMovers(dt, m_BounceLoss, &m_Jobs);
+        return;
     }
 
-    for (auto& mp : m_Movable)
-        mp.Step(dt, 0.f, 0.f, m_Window.width, m_Window.height, m_BounceLoss);
+    // movers out of view step less often with the time they skipped, resting
+    // ones sleep; the level view is the window at the origin (PublishSnapshot)
+    m_MoverLod.Schedule(m_Movable, 0.f, 0.f, m_Window.width, m_Window.height, dt);
+    const auto& due = m_MoverLod.Due();
+    const auto& dueDt = m_MoverLod.DueDt();
+
+    m_Jobs.ParallelFor(due.size(), 16, [this, &due, &dueDt](size_t b, size_t e) {
+        for (size_t k = b; k < e; ++k) {
+            auto& mp = m_Movable[due[k]];
+            const float h = dueDt[k];
+            if (mp.mode == gameplay::MovablePillar::Mode::Seek) {
+                // chase the next cell toward the player, straight on in the last one
+                float wx, wy;
+                if (m_SeekFlow.NextWaypoint(mp.C[0], mp.C[1], wx, wy)) mp.target = ThreeBlade(wx, wy, 0.f);
+                else if (!m_SeekFlow.Empty()) mp.target = m_SeekGoal;
+            }
+            mp.Step(h, 0.f, 0.f, m_Window.width, m_Window.height, m_BounceLoss);
+            mp.CollideWalls(m_Maze, m_BounceLoss);
+        }
+    });
+
+    gameplay::MovablePillar::CollidePillars(m_Movable, m_MovableBroadphase, m_BounceLoss, &m_Maze,
+                                            m_MoverLod.Stepped());
+}
+
+// runs before the frame graph: reads the player, which the graph moves
+void Game::UpdateSeekFlow()
+{
+    if (m_WorldMode || m_SeekFlow.Empty()) return;
 
-    std::vector<std::pair<ThreeBlade,gameplay::PillarType>> pillars;
-    pillars.reserve(m_PillarArray.size() + m_Movable.size() + m_Reflectors.size());
-    pillars.insert(pillars.end(), m_PillarArray.begin(), m_PillarArray.end());
-    for (const auto& mp : m_Movable)    pillars.emplace_back(mp.C, ToPillarType(mp));
-    for (const auto& rp : m_Reflectors) pillars.emplace_back(rp.Center(), gameplay::PillarType::Reflect);
+    m_SeekGoal = ThreeBlade(m_Character[0], m_Character[1], 0.f);
+    int cx, cy;
+    if (m_SeekFlow.CellAt(m_Character[0], m_Character[1], cx, cy)) m_SeekFlow.Retarget(cx, cy);
+    m_SeekFlow.Advance(m_SeekFlowBudget);
+}
 
-    int total = int(pillars.size());
+void Game::GatherPillars(float dt)
+{
+    // static pillars first: the baked gravity field relies on that order
+    m_FrameBlades.clear();
+    if (m_WorldMode) {
+        m_World.GatherPillars(m_WorldPillars);
+        for (const auto& pr : m_WorldPillars) m_FrameBlades.push_back(pr.first);
+    } else {
+        m_FrameBlades.reserve(m_PillarArray.size() + m_Movable.size() + m_Reflectors.size());
+        for (const auto& pr : m_PillarArray) m_FrameBlades.push_back(pr.first);
+        for (const auto& mp : m_Movable)     m_FrameBlades.push_back(mp.C);
+        for (const auto& rp : m_Reflectors)  m_FrameBlades.push_back(rp.Center());
+    }
+
+    int total = int(m_FrameBlades.size());
     int active = -1;
     if (total > 0) {
         if (m_CurrentPillarIndex < 0 || m_CurrentPillarIndex >= total) m_CurrentPillarIndex = 0;
@@ -408,167 +609,230 @@ void Game::Integrate(float dt)
         active = -1;
     }
 
-    std::vector<ThreeBlade> blades;
-    blades.reserve(pillars.size());
-    std::transform(pillars.begin(), pillars.end(), std::back_inserter(blades),
-                   [](const auto& pr){ return pr.first; });
+    m_FrameActiveSet.clear();
+    if (active >= 0) m_FrameActiveSet.push_back(active);
+}
 
-    std::vector<int> activeSet;
-    if (active >= 0) activeSet.push_back(active);
+// Free distance from the player to the nearest wall or pillar pull, 0 when
+// unknown. Walls come from the maze SDF (bilinear, so good to about a cell);
+// pillars count from gravMinR, where their pull stops being softened.
+float Game::PlayerClearance() const
+{
+    float clear = 0.f;
+    if (m_WorldMode || !m_Maze.sdf.SampleDistance(m_Character[0], m_Character[1], clear))
+        return 0.f;
+    clear -= m_CharacterRadius;
+
+    const float minR = gameplay::PlayerController::Tuning{}.gravMinR;
+    for (const ThreeBlade& P : m_FrameBlades)
+        clear = std::min(clear, (m_Character & P).Norm() - minR);
+    return std::max(clear, 0.f);
+}
+
+// Splits the frame into as many substeps as the player's speed needs near
+// walls and pillars; the wall contacts are re-solved between substeps the
+// way IntegratePlayerPre does before the first one, and each substep ends
+// with one trigger update.
+void Game::IntegratePlayer(float dt)
+{
+    const float thickness = m_WorldMode ? m_World.Params().wallThickness : m_Maze.wallThickness;
+    const float speed = std::sqrt(m_Vx * m_Vx + m_Vy * m_Vy);
+    const int n = m_Substeps.Choose(speed, dt, thickness, PlayerClearance());
+
+    const float h = dt / float(n);
+    for (int k = 0; k < n; ++k) {
+        if (k > 0) ResolvePlayer();
+        StepPlayer(h);
+    }
+}
 
+void Game::StepPlayer(float dt)
+{
     gameplay::InputState in{ m_HoldUp, m_HoldDown, m_HoldLeft, m_HoldRight, m_HoldBoost };
     gameplay::PlayerController::Tuning tune{}; tune.bounceLoss = m_BounceLoss;
 
+    const ThreeBlade from = m_Character;
     gameplay::PlayerController::StepKinematics(
-        m_Character, m_Vx, m_Vy, m_VzEnergy, in, blades, activeSet, dt, tune);
+        m_Character, m_Vx, m_Vy, m_VzEnergy, in, m_FrameBlades, m_FrameActiveSet, dt, tune,
+        m_WorldMode ? nullptr : &m_StaticGravity);
+
+    // replay the step as a sweep so fast moves stop at walls instead of tunnelling
+    const float dx = m_Character[0] - from[0];
+    const float dy = m_Character[1] - from[1];
+    m_Character = from;
+    if (m_WorldMode) {
+        m_World.SweepMove(m_Character, dx, dy, m_Vx, m_Vy, m_CharacterRadius, m_BounceLoss);
+        return;
+    }
+    gameplay::CollisionSystemMaze::SweepMove(
+        m_Maze, m_Character, dx, dy, m_Vx, m_Vy, m_CharacterRadius, m_BounceLoss);
 
-    bool reflectedAfter = false;
-    for (auto& rp : m_Reflectors)
-        reflectedAfter |= rp.TryReflect(m_Character, m_Vx, m_Vy, dt);
+    m_Triggers.Update(m_Character, m_CharacterRadius);
 
-    if (reflectedAfter) {
+    if (ApplyReflectorEvents()) {
         gameplay::CollisionSystemMaze::DepenetratePosition(
-            m_Maze, m_Character, m_CharacterRadius, 16, 0.75f);
+            m_Maze, m_Character, m_CharacterRadius, 16, 0.75f, &m_PlayerContacts);
     }
+}
 
-    for (size_t i = 0; i < m_Collectibles.size(); ++i) {
-        if (m_Collected[i]) continue;
-        float r = DistPGA(m_Character, m_Collectibles[i]);
-        if (r <= (m_CharacterRadius + m_CollectibleRadius)) {
-            m_Collected[i] = 1;
-            m_CollectiblesRemaining--;
-            std::cout << "Collected " << (i + 1) << " / total, remaining: " << m_CollectiblesRemaining << "\n";
-        }
-    }
+void Game::StepFish(float dt)
+{
+    // the crowd lives in the level's window bounds
+    if (m_Fish.Size() == 0 || m_WorldMode) return;
 
-    {
-        float R = DistPGA(m_Character, m_Maze.endCenter);
-        if (R <= (m_Maze.endRadius + m_CharacterRadius)) {
-            if (m_CollectiblesRemaining == 0) {
-                std::cout << "Reached end point\n";
-
-                // new random maze
-                gameplay::MazeGenerator::Generate(
-                    m_Maze, 14, 10, 80.f, 20.f,
-                    m_Window.width, m_Window.height, 0);
-
-                // spawn player at the new start
-                m_Character = m_Maze.startCenter;
-                m_Vx = 0.f; m_Vy = 0.f; m_VzEnergy = 0.f;
-
-                // new pillars and collectibles
-                SpawnRandomPillars(2, 80.f);
-                SpawnCollectibles(2, 5, 60.f);
-
-                // pick a fresh active pillar
-                int newTotal = int(m_PillarArray.size() + m_Movable.size() + m_Reflectors.size());
-                if (newTotal > 0) {
-                    std::uniform_int_distribution<int> pick(0, newTotal - 1);
-                    m_CurrentPillarIndex = pick(m_Rng);
-                } else {
-                    m_CurrentPillarIndex = -1;
-                }
-                m_ActiveRotateTimer = 0.f;
+    gameplay::PlayerController::Tuning tune{}; tune.bounceLoss = m_BounceLoss;
 
-            }
-        }
-    }
+    gameplay::AgentBatchSim::Scene scene;
+    scene.maze       = &m_Maze;
+    scene.pillars    = &m_FrameBlades;
+    scene.activeSet  = &m_FrameActiveSet;
+    scene.reflectors = &m_Reflectors;
+    scene.baked      = &m_StaticGravity;
+    scene.width      = m_Window.width;
+    scene.height     = m_Window.height;
+
+    auto st = gameplay::AgentBatchSim::Step(m_Fish, scene, dt, tune, &m_Jobs);
+    m_FishStats.agents   = st.agents;
+    m_FishStats.steps   += st.steps;
+    m_FishStats.seconds += st.seconds;
 }
 
-void Game::SpawnRandomPillars(int maxPerType, float margin)
+// solver counters gathered by the frame tasks, printed here on the sim
+// thread once the graph has finished
+void Game::ReportStats(float dt)
 {
-    // wipe existing
-    m_PillarArray.clear();
-    m_Movable.clear();
-    m_Reflectors.clear();
-
-    std::uniform_int_distribution<int>   count(0, maxPerType);
-    std::uniform_real_distribution<float> xDist(margin, m_Window.width  - margin);
-    std::uniform_real_distribution<float> yDist(margin, m_Window.height - margin);
-
-    // params
-    std::uniform_real_distribution<float> speedDist(40.f, 120.f);
-    std::uniform_real_distribution<float> omegaDist(-1.8f, 1.8f);
-    std::uniform_real_distribution<float> orbitRDist(80.f, 160.f);
-    std::uniform_real_distribution<float> maxSpeedDist(100.f, 180.f);
-    std::uniform_real_distribution<float> accelDist(250.f, 480.f);
-    std::uniform_real_distribution<float> triggerDist(70.f, 140.f);
-
-    const int nNormal = count(m_Rng);
-    const int nMovable = count(m_Rng);
-    const int nLinear  = count(m_Rng);
-    const int nSeek    = count(m_Rng);
-    const int nReflect = count(m_Rng);
-
-    // unit dir from join
-    auto unitDirFromJoin = [&](const ThreeBlade& P, float& ux, float& uy)
-    {
-        for (int tries = 0; tries < 16; ++tries) {
-            ThreeBlade Q(xDist(m_Rng), yDist(m_Rng), 0.f);
-            TwoBlade  L = P & Q;
-            float dx = L[3], dy = L[4];
-            float n2 = dx*dx + dy*dy;
-            if (n2 > 1e-8f) {
-                float inv = 1.0f / std::sqrt(n2);
-                ux = dx * inv; uy = dy * inv;
-                return true;
-            }
+    m_StatsReportTimer += dt;
+    if (m_StatsReportTimer < 5.f) return;
+
+    if (m_ShowSolverStats) {
+        if (m_PlayerContacts.solves > 0) {
+            std::cout << "Wall contacts: " << m_PlayerContacts.solves << " solves, "
+                      << m_PlayerContacts.AvgIterations() << " iterations avg ("
+                      << m_PlayerContacts.maxIterations << " max)\n";
         }
-        ux = 1.f; uy = 0.f;
-        return false;
-    };
+        const auto& sub = m_Substeps.GetStats();
+        if (sub.frames > 0) {
+            std::cout << "Player substeps: " << sub.Average() << " avg, "
+                      << sub.maxUsed << " max, " << sub.capped << " capped, "
+                      << (sub.frames - sub.histogram[0]) << "/" << sub.frames << " frames split\n";
+        }
+        const auto& mov = m_MoverLod.GetStats();
+        if (mov.movers > 0) {
+            std::cout << "Movers: " << mov.SteppedPerFrame() << " stepped/frame of "
+                      << (mov.movers / mov.frames) << ", " << mov.coarse << " coarse steps, "
+                      << (mov.sleeping / mov.frames) << " asleep\n";
+        }
+        if (m_FishStats.agents > 0) {
+            std::cout << "Fish: " << m_FishStats.agents << " agents, "
+                      << m_FishStats.AgentStepsPerSecond() << " agent-steps/s ("
+                      << (m_Jobs.WorkerCount() + 1) << " threads)\n";
+        }
+    }
+    m_StatsReportTimer = 0.f;
+    m_PlayerContacts = {};
+    m_Substeps.ResetStats();
+    m_MoverLod.ResetStats();
+    m_FishStats = {};
+}
 
-    // Normal static pillars (white)
-    for (int i = 0; i < nNormal; ++i) {
-        ThreeBlade c(xDist(m_Rng), yDist(m_Rng), 0.f);
-        m_PillarArray.emplace_back(c, gameplay::PillarType::Normal);
+void Game::CheckPickups()
+{
+    if (m_WorldMode) {
+        if (int n = m_World.CheckPickups(m_Character, m_CharacterRadius); n > 0)
+            std::cout << "Collected " << n << " in tile world\n";
+        return;
     }
 
-    // Movable (orbit)
-    for (int i = 0; i < nMovable; ++i) {
-        ThreeBlade anchor(xDist(m_Rng), yDist(m_Rng), 0.f);
-        float ux, uy; unitDirFromJoin(anchor, ux, uy);
-        float R = orbitRDist(m_Rng);
+    // only the cells under the player are looked at
+    m_Picked.clear();
+    m_CollectibleField.Collect(m_Character[0], m_Character[1], m_CharacterRadius, &m_Picked);
+    for (uint32_t i : m_Picked)
+        std::cout << "Collected " << (i + 1) << " / total, remaining: " << m_CollectibleField.Remaining() << "\n";
 
-        Motor T = gameplay::GeoMotors::MakeTranslator(R * ux, R * uy);
-        ThreeBlade start = gameplay::GeoMotors::Apply(anchor, T);
+    // the end gate is a trigger, touched in the last update
+    bool atEnd = false;
+    for (const auto& ev : m_Triggers.Events())
+        atEnd |= ev.kind != gameplay::TriggerEvent::Exit && m_Triggers.Tag(ev.trigger) == kTriggerEndGate;
 
-        float w = omegaDist(m_Rng);
-        m_Movable.push_back(
-            gameplay::MovablePillar::MakeOrbit(anchor, start, w, 240.f));
-    }
+    if (atEnd && m_CollectibleField.Remaining() == 0) {
+        std::cout << "Reached end point\n";
 
-    // Linear movers
-    for (int i = 0; i < nLinear; ++i) {
-        ThreeBlade S(xDist(m_Rng), yDist(m_Rng), 0.f);
-        float ux, uy; unitDirFromJoin(S, ux, uy);
-        float s = speedDist(m_Rng);
-        float vx = s * ux;
-        float vy = s * uy;
-        m_Movable.push_back(
-            gameplay::MovablePillar::MakeLinear(S, vx, vy, 240.f));
+        NextLevel();
     }
+}
+
+void Game::RebuildTriggers()
+{
+    m_Triggers.Clear();
+
+    // reflectors fire on the player's centre, like ReflectPillar::TryReflect
+    for (const auto& rp : m_Reflectors)
+        m_Triggers.AddCircle(rp.C[0], rp.C[1], rp.triggerR, kTriggerReflector, gameplay::TriggerSystem::kPoint);
+
+    m_Triggers.AddCircle(m_Maze.endCenter[0], m_Maze.endCenter[1], m_Maze.endRadius, kTriggerEndGate);
+    m_TriggersDirty = false;
+}
 
-    // Seekers
-    for (int i = 0; i < nSeek; ++i) {
-        ThreeBlade start (xDist(m_Rng), yDist(m_Rng), 0.f);
-        ThreeBlade target(xDist(m_Rng), yDist(m_Rng), 0.f);
-        float ms = maxSpeedDist(m_Rng);
-        float ac = accelDist(m_Rng);
-        m_Movable.push_back(
-            gameplay::MovablePillar::MakeSeek(start, target, ms, ac, 240.f));
+// half-turn on entering a reflector; true if the player was moved
+bool Game::ApplyReflectorEvents()
+{
+    bool reflected = false;
+    for (const auto& ev : m_Triggers.Events()) {
+        if (ev.kind != gameplay::TriggerEvent::Enter || m_Triggers.Tag(ev.trigger) != kTriggerReflector)
+            continue;
+        m_Reflectors[ev.trigger].Reflect(m_Character, m_Vx, m_Vy);
+        reflected = true;
     }
+    return reflected;
+}
 
-    // Reflectors
-    for (int i = 0; i < nReflect; ++i) {
-        float x = xDist(m_Rng), y = yDist(m_Rng);
-        float tr = triggerDist(m_Rng);
-        m_Reflectors.push_back(
-            gameplay::ReflectPillar::Make(ThreeBlade(x, y, 0.f), tr));
+uint32_t Game::NextLevelSeed()
+{
+    uint32_t seed = 0;
+    while (seed == 0) seed = m_Rng();   // 0 would mean random_device
+    return seed;
+}
+
+void Game::NextLevel()
+{
+    // on rapid restarts this waits for the level being built instead of
+    // building an out-of-sequence one, so a seed always replays the same order
+    LoadLevel(m_LevelPipeline.Pop());
+}
+
+void Game::LoadLevel(gameplay::LevelData&& lvl)
+{
+    m_WorldMode = false;
+    std::cout << "Level seed " << lvl.seed << " (maze cache: " << m_MazeCache.Hits()
+              << " hits, " << m_MazeCache.Misses() << " misses)\n";
+
+    // swap the whole level in at once, between two frames
+    m_Maze          = std::move(lvl.maze);
+    m_PillarArray   = std::move(lvl.pillars);
+    m_Movable       = std::move(lvl.movable);
+    m_MoverLod.Reset();
+    m_MovableBroadphase.Clear();
+    m_Reflectors    = std::move(lvl.reflectors);
+    m_Collectibles  = std::move(lvl.collectibles);
+    m_StaticGravity = std::move(lvl.staticGravity);
+
+    if (m_SeekFlow.Reset(m_Maze)) {
+        int cx, cy;
+        if (m_SeekFlow.CellAt(m_Maze.startCenter[0], m_Maze.startCenter[1], cx, cy))
+            m_SeekFlow.Build(cx, cy);
     }
 
-    // reset active rotation timer and choose a new active if possible
-    m_ActiveRotateTimer = 0.f;
+    if (m_Maze.rawWallCount != m_Maze.walls.size())
+        std::cout << "Maze walls: " << m_Maze.rawWallCount << " -> " << m_Maze.walls.size() << " after merge\n";
+
+    m_CollectibleField.Build(m_Collectibles, m_CollectibleRadius);
+    m_TriggersDirty = true;
+
+    // spawn player at the new start
+    m_Character = m_Maze.startCenter;
+    m_Vx = 0.f; m_Vy = 0.f; m_VzEnergy = 0.f;
+
+    // pick a fresh active pillar
     int total = int(m_PillarArray.size() + m_Movable.size() + m_Reflectors.size());
     if (total > 0) {
         std::uniform_int_distribution<int> pick(0, total - 1);
@@ -576,76 +840,80 @@ void Game::SpawnRandomPillars(int maxPerType, float margin)
     } else {
         m_CurrentPillarIndex = -1;
     }
+    m_ActiveRotateTimer = 0.f;
 }
-void Game::SpawnCollectibles(int minCount, int maxCount, float margin)
-{
-    m_Collectibles.clear();
-    m_Collected.clear();
 
-    if (minCount > maxCount) std::swap(minCount, maxCount);
+void Game::EnterWorldMode()
+{
+    m_WorldParams.seed = NextLevelSeed();
+    m_World.Reset(m_WorldParams);
+    m_WorldMode = true;
 
-    std::uniform_int_distribution<int> nDist(minCount, maxCount);
-    std::uniform_real_distribution<float> xDist(margin, m_Window.width  - margin);
-    std::uniform_real_distribution<float> yDist(margin, m_Window.height - margin);
+    m_Character = m_World.SpawnPoint();
+    m_Vx = 0.f; m_Vy = 0.f; m_VzEnergy = 0.f;
 
-    const int n = nDist(m_Rng);
-    m_Collectibles.reserve(n);
-    m_Collected.assign(n, 0);
-    m_CollectiblesRemaining = n;
+    m_CameraX = m_Character[0] - 0.5f * m_Window.width;
+    m_CameraY = m_Character[1] - 0.5f * m_Window.height;
+    m_World.Update(m_CameraX, m_CameraY, m_CameraX + m_Window.width, m_CameraY + m_Window.height);
 
-    const float sep = 2.0f * m_CollectibleRadius + 8.f;   // min spacing between collectibles
-    const float pad = 2.0f;                               // tiny padding from walls
+    m_CurrentPillarIndex = -1;
+    m_ActiveRotateTimer = 0.f;
+    std::cout << "Tile world (seed " << m_WorldParams.seed << ")\n";
+}
 
-    for (int i = 0; i < n; ++i) {
-        ThreeBlade c(0.f, 0.f, 0.f);
-        bool placed = false;
+void Game::UpdateCamera(float dt)
+{
+    // exponential follow, framerate independent
+    const float k = 1.f - std::exp(-m_CameraFollow * dt);
+    m_CameraX += (m_Character[0] - 0.5f * m_Window.width  - m_CameraX) * k;
+    m_CameraY += (m_Character[1] - 0.5f * m_Window.height - m_CameraY) * k;
 
-        for (int tries = 0; tries < 128 && !placed; ++tries) {
-            float x = xDist(m_Rng), y = yDist(m_Rng);
-            ThreeBlade cand(x, y, 0.f);
+    m_World.Update(m_CameraX, m_CameraY, m_CameraX + m_Window.width, m_CameraY + m_Window.height);
+}
 
-            if (CircleOverlapsAnyWall(m_Maze, x, y, m_CollectibleRadius + pad)) continue;
+void Game::SpawnRandomPillars(int maxPerType, float margin)
+{
+    gameplay::LevelParams p = m_LevelParams;
+    p.pillarsPerType = maxPerType;
+    p.pillarMargin   = margin;
+    gameplay::LevelBuilder::SpawnPillars(m_Rng, p, m_PillarArray, m_Movable, m_Reflectors);
+    m_MovableBroadphase.Clear();
+    m_TriggersDirty = true;
+    RebuildStaticGravity();
 
-            if (DistPGA(cand, m_Maze.startCenter) < (m_CollectibleRadius + 20.f)) continue;
-            if (DistPGA(cand, m_Maze.endCenter)   < (m_CollectibleRadius + m_Maze.endRadius + 10.f)) continue;
+    // reset active rotation timer and choose a new active if possible
+    m_ActiveRotateTimer = 0.f;
+    int total = int(m_PillarArray.size() + m_Movable.size() + m_Reflectors.size());
+    if (total > 0) {
+        std::uniform_int_distribution<int> pick(0, total - 1);
+        m_CurrentPillarIndex = pick(m_Rng);
+    } else {
+        m_CurrentPillarIndex = -1;
+    }
+}
 
-            bool ok = true;
-            for (const auto& other : m_Collectibles) {
-                if (DistPGA(cand, other) < sep) { ok = false; break; }
-            }
-            if (!ok) continue;
+void Game::RebuildStaticGravity()
+{
+    gameplay::LevelBuilder::BakeStaticGravity(m_LevelParams, m_PillarArray, m_StaticGravity);
+}
 
-            c = cand;
-            placed = true;
-        }
+void Game::SpawnFish(int count)
+{
+    const float pad = 20.f;
+    std::uniform_real_distribution<float> xDist(pad, m_Window.width  - pad);
+    std::uniform_real_distribution<float> yDist(pad, m_Window.height - pad);
+    std::uniform_real_distribution<float> vDist(-60.f, 60.f);
 
-        if (!placed) {
-            // fallback -> scan outward a bit around start center until free
-            float sx = m_Maze.startCenter[0], sy = m_Maze.startCenter[1];
-            for (int k = 0; k < 64 && !placed; ++k) {
-                float dx = (k % 16) * 6.f;
-                float dy = (k / 16) * 6.f;
-                float x = std::clamp(sx + dx, margin, m_Window.width  - margin);
-                float y = std::clamp(sy + dy, margin, m_Window.height - margin);
-                if (!CircleOverlapsAnyWall(m_Maze, x, y, m_CollectibleRadius + pad)) {
-                    c = ThreeBlade(x, y, 0.f);
-                    placed = true;
-                }
-            }
-            if (!placed) {
-                // drop anywhere (still check walls)
-                float x = xDist(m_Rng), y = yDist(m_Rng);
-                if (CircleOverlapsAnyWall(m_Maze, x, y, m_CollectibleRadius + pad)) {
-                    // nudge out by a tiny epsilon
-                    x += 2.f; y += 2.f;
-                }
-                c = ThreeBlade(x, y, 0.f);
-            }
+    m_Fish.Reserve(m_Fish.Size() + size_t(std::max(count, 0)));
+    for (int i = 0; i < count; ++i) {
+        float x = xDist(m_Rng), y = yDist(m_Rng);
+        for (int tries = 0; tries < 8 && CircleOverlapsAnyWall(m_Maze, x, y, m_Fish.radius + 1.f); ++tries) {
+            x = xDist(m_Rng); y = yDist(m_Rng);
         }
-
-        m_Collectibles.push_back(c);
+        m_Fish.Add(x, y, vDist(m_Rng), vDist(m_Rng));
     }
 }
+
 void Game::HandleWallCollisions()
 {
     gameplay::CollisionSystem::ResolveWalls(
@@ -653,49 +921,61 @@ void Game::HandleWallCollisions()
         m_CharacterRadius, m_Window.width, m_Window.height, m_BounceLoss);
 }
 
-// drawing
-void Game::DrawPillars() const
+// drawing (render thread, snapshot only)
+void Game::DrawPillars(const gameplay::FrameSnapshot& snap) const
+{
+    gameplay::PillarRenderer::Draw(snap.pillars, snap.active);
+}
+
+void Game::DrawCollectibles(const gameplay::FrameSnapshot& snap) const
 {
-    std::vector<std::pair<ThreeBlade,gameplay::PillarType>> pillars;
-    pillars.reserve(m_PillarArray.size() + m_Movable.size() + m_Reflectors.size());
-    pillars.insert(pillars.end(), m_PillarArray.begin(), m_PillarArray.end());
-    for (const auto& mp : m_Movable)    pillars.emplace_back(mp.C, ToPillarType(mp));
-    for (const auto& rp : m_Reflectors) pillars.emplace_back(rp.Center(), gameplay::PillarType::Reflect);
+    const float r = snap.collectibleRadius;
+    auto drawCollected = [&](float x, float y) {
+        // faint outline for collected
+        SetColor(Color4f{0.4f, 0.9f, 0.5f, 0.35f});
+        DrawCircle(x, y, r + 2.f);
+    };
+    auto drawLive = [&](float x, float y) {
+        // solid for not collected
+        SetColor(Color4f{0.4f, 0.9f, 0.5f, 0.95f});
+        FillCircle(x, y, r);
+        SetColor(Color4f{0.1f, 0.3f, 0.15f, 0.9f});
+        DrawCircle(x, y, r + 2.f);
+    };
 
-    int active = pillars.empty() ? -1
-               : std::clamp(m_CurrentPillarIndex, 0, int(pillars.size()) - 1);
+    if (const auto& field = snap.collectibleField) {
+        // occupied cells in view only
+        const float pad = r + 2.f;
+        field->ForEachCell(snap.cameraX - pad, snap.cameraY - pad,
+                           snap.cameraX + m_Window.width + pad, snap.cameraY + m_Window.height + pad,
+                           [&](uint32_t b, uint32_t live, uint32_t e) {
+            for (uint32_t s = live; s < e; ++s) drawCollected(field->x[s], field->y[s]);
+            for (uint32_t s = b; s < live; ++s) drawLive(field->x[s], field->y[s]);
+        });
+        return;
+    }
 
-    gameplay::PillarRenderer::Draw(pillars, active);
+    for (size_t i = 0; i < snap.collectibles.size(); ++i) {
+        const ThreeBlade& C = snap.collectibles[i];
+        if (snap.collected[i]) drawCollected(C[0], C[1]);
+        else drawLive(C[0], C[1]);
+    }
 }
 
-void Game::DrawCollectibles() const
+void Game::DrawFish(const gameplay::FrameSnapshot& snap) const
 {
-    // simple circles for collectibles
-    for (size_t i = 0; i < m_Collectibles.size(); ++i) {
-        const ThreeBlade& C = m_Collectibles[i];
-        if (m_Collected[i]) {
-            // faint outline for collected
-            SetColor(Color4f{0.4f, 0.9f, 0.5f, 0.35f});
-            DrawCircle(C[0], C[1], m_CollectibleRadius + 2.f);
-        } else {
-            // solid for not collected
-            SetColor(Color4f{0.4f, 0.9f, 0.5f, 0.95f});
-            FillCircle(C[0], C[1], m_CollectibleRadius);
-            SetColor(Color4f{0.1f, 0.3f, 0.15f, 0.9f});
-            DrawCircle(C[0], C[1], m_CollectibleRadius + 2.f);
-        }
-    }
+    gameplay::AgentRenderer::Draw(snap.fishX, snap.fishY, snap.fishEnergy, snap.fishRadius);
 }
 
-void Game::DrawCharacter() const
+void Game::DrawCharacter(const gameplay::FrameSnapshot& snap) const
 {
-    gameplay::PlayerRenderer::Draw(m_Character, m_CharacterRadius, m_VzEnergy);
+    gameplay::PlayerRenderer::Draw(snap.character, snap.characterRadius, snap.vzEnergy);
 }
 
-void Game::DrawHUD() const
+void Game::DrawHUD(const gameplay::FrameSnapshot& snap) const
 {
     // You can add collectibles remaining text to your HUD if desired.
-    gameplay::HUDRenderer::Draw(m_Vx, m_Vy, m_MaxSpeed, m_VzEnergy, m_Window.height);
+    gameplay::HUDRenderer::Draw(snap.vx, snap.vy, snap.maxSpeed, snap.vzEnergy, m_Window.height);
 }
 
 // PGA wrappers
@@ -723,6 +1003,8 @@ ThreeBlade Game::ApplyMotor(const ThreeBlade& X, const Motor& M)
 void Game::AddPillar(const ThreeBlade& center)
 {
     m_PillarArray.emplace_back(center, gameplay::PillarType::Normal);
+    if (m_StaticGravity.Empty()) RebuildStaticGravity();
+    else m_StaticGravity.AddPillar(center);
 }
 
 void Game::GEOAClone()
@@ -734,82 +1016,18 @@ void Game::AddReflector(const ThreeBlade& c, float triggerR, float cooldown)
 {
     (void)cooldown;
     m_Reflectors.push_back(gameplay::ReflectPillar::Make(c, triggerR, cooldown));
+    m_TriggersDirty = true;
 }
 
 
 float Game::DistPGA(const ThreeBlade& A, const ThreeBlade& B)
 {
-    TwoBlade L = A & B;
-    return L.Norm();
+    return gameplay::GeoMotors::Distance(A, B);
 }
 
 
-/// keep this helper once, near the top (not duplicated)
-OneBlade Game::UnitLine(float a, float b, float c)
-{
-    const float n = std::sqrt(std::max(1e-12f, a*a + b*b));
-    return OneBlade(c / n, a / n, b / n, 0.0f);
-}
-
 bool Game::CircleOverlapsAnyWall(const gameplay::Maze& maze,
                                  float cx, float cy, float r)
 {
-    const ThreeBlade X(cx, cy, 0.f);
-
-    for (const auto& w : maze.walls)
-    {
-        const float left   = w.x;
-        const float right  = w.x + w.w;
-        const float bottom = w.y;
-        const float top    = w.y + w.h;
-
-        const OneBlade L = UnitLine(+1.f,  0.f, -left);
-        const OneBlade R = UnitLine(-1.f,  0.f, +right);
-        const OneBlade B = UnitLine( 0.f, +1.f, -bottom);
-        const OneBlade T = UnitLine( 0.f, -1.f, +top);
-
-        const float sL = L & X;
-        const float sR = R & X;
-        const float sB = B & X;
-        const float sT = T & X;
-
-        const bool insideX = (sL >= 0.f && sR >= 0.f);
-        const bool insideY = (sB >= 0.f && sT >= 0.f);
-
-        if (insideX && insideY)
-        {
-            const float dEdge = std::min(std::min(sL, sR), std::min(sB, sT));
-            if (dEdge <= r) return true;
-        }
-        else if (insideY && sL < 0.f)
-        {
-            if (-sL <= r) return true;
-        }
-        else if (insideY && sR < 0.f)
-        {
-            if (-sR <= r) return true;
-        }
-        else if (insideX && sB < 0.f)
-        {
-            if (-sB <= r) return true;
-        }
-        else if (insideX && sT < 0.f)
-        {
-            if (-sT <= r) return true;
-        }
-        else
-        {
-            const ThreeBlade CBL(left,  bottom, 0.f);
-            const ThreeBlade CBR(right, bottom, 0.f);
-            const ThreeBlade CTL(left,  top,    0.f);
-            const ThreeBlade CTR(right, top,    0.f);
-
-            if (DistPGA(X, CBL) <= r) return true;
-            if (DistPGA(X, CBR) <= r) return true;
-            if (DistPGA(X, CTL) <= r) return true;
-            if (DistPGA(X, CTR) <= r) return true;
-        }
-    }
-    return false;
+    return gameplay::CollisionSystemMaze::CircleOverlapsAnyWall(maze, cx, cy, r);
 }
-
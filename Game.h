@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <vector>
 #include <memory>
 #include <random>
@@ -7,15 +8,31 @@
 
 #include "utils.h"
 #include "FlyFish.h"
+#include "Gameplay/AgentBatch.h"
+#include "Gameplay/Broadphase.h"
+#include "Gameplay/CollectibleField.h"
+#include "Gameplay/CollisionSystemMaze.h"
+#include "Gameplay/FrameSnapshot.h"
+#include "Gameplay/GravityField.h"
+#include "Gameplay/JobSystem.h"
+#include "Gameplay/LevelBuilder.h"
+#include "Gameplay/LevelPipeline.h"
 #include "Gameplay/Maze.h"
+#include "Gameplay/MazeCache.h"
 #include "Gameplay/MovablePillar.h"
+#include "Gameplay/MoverScheduler.h"
 #include "Gameplay/PillarRenderer.h"
 #include "Gameplay/ReflecPillar.h"
+#include "Gameplay/SubstepController.h"
+#include "Gameplay/TripleBuffer.h"
+#include "Gameplay/TriggerSystem.h"
+#include "Gameplay/WorldChunks.h"
 
 class Game
 {
 public:
-    explicit Game(const Window& window);
+    // seed != 0 replays the same level sequence (and hits the maze cache)
+    explicit Game(const Window& window, uint32_t seed = 0);
     ~Game();
 
     void Run();
@@ -27,8 +44,6 @@ public:
 
     float DistPGA(const ThreeBlade &A, const ThreeBlade &B);
 
-    OneBlade UnitLine(float a, float b, float c);
-
     bool CircleOverlapsAnyWall(const gameplay::Maze &maze, float cx, float cy, float r);
 
     // PGA wrappers
@@ -46,22 +61,57 @@ private:
     void ProcessKeyUpEvent(const SDL_KeyboardEvent& e);
 
     void Update(float dt);
-    void Draw() const;
+    // render thread: owns the GL context, draws only from snapshots
+    void RenderLoop();
+    void PublishSnapshot();
+
+    void Draw(const gameplay::FrameSnapshot& snap) const;
+    void ApplyCamera(float x, float y) const;
 
-    void DrawPillars() const;
-    void DrawCollectibles() const;
-    void DrawCharacter() const;
-    void DrawHUD() const;
+    void DrawPillars(const gameplay::FrameSnapshot& snap) const;
+    void DrawCollectibles(const gameplay::FrameSnapshot& snap) const;
+    void DrawCharacter(const gameplay::FrameSnapshot& snap) const;
+    void DrawHUD(const gameplay::FrameSnapshot& snap) const;
+    void DrawFish(const gameplay::FrameSnapshot& snap) const;
 
     void Integrate(float dt);
+    void IntegratePlayerPre();
+    void StepMovers(float dt);
+    void UpdateSeekFlow();
+    void GatherPillars(float dt);
+    void IntegratePlayer(float dt);
+    void StepPlayer(float dt);
+    void ResolvePlayer();
+    float PlayerClearance() const;
+    void StepFish(float dt);
+    void CheckPickups();
+    void ReportStats(float dt);
+    void RebuildTriggers();
+    bool ApplyReflectorEvents();
     void HandleWallCollisions();
     void SpawnOutsideInfluence(float minClearance);
 
+    // levels
+    uint32_t NextLevelSeed();
+    void NextLevel();
+    void LoadLevel(gameplay::LevelData&& lvl);
+
+    // endless chunked world
+    void EnterWorldMode();
+    void UpdateCamera(float dt);
+
     // random spawners
     void SpawnRandomPillars(int maxPerType = 2, float margin = 80.f);
-    void SpawnCollectibles(int minCount = 2, int maxCount = 5, float margin = 60.f);
+    void RebuildStaticGravity();
+    void SpawnFish(int count);
 
 private:
+    // frame phases run as a task graph on the job system
+    gameplay::JobSystem m_Jobs;
+    gameplay::TaskGraph m_FrameGraph;
+    std::vector<ThreeBlade> m_FrameBlades;     // all pillar centers this frame
+    std::vector<int>        m_FrameActiveSet;
+
     // window + GL
     Window m_Window;
     SDL_Rect m_Viewport{0,0,0,0};
@@ -70,7 +120,16 @@ private:
     std::unique_ptr<void,       void(*)(void*)>       m_pContext{nullptr, SDL_GL_DeleteContext};
 
     bool  m_Initialized{false};
-    float m_MaxElapsedSeconds{1.f/60.f};
+    // the player's move is swept against the walls, so long steps don't tunnel
+    float m_MaxElapsedSeconds{1.f/30.f};
+    float m_SimTickSeconds{1.f/60.f};
+
+    // sim -> render handoff
+    gameplay::TripleBuffer<gameplay::FrameSnapshot> m_Snapshots;
+    std::shared_ptr<const gameplay::Maze> m_PublishedMaze;
+    std::shared_ptr<const gameplay::CollectibleField> m_PublishedCollectibles;
+    uint64_t m_SimFrame{0};
+    std::atomic<bool> m_RenderQuit{false};
 
     // player
     ThreeBlade m_Character{};
@@ -85,8 +144,13 @@ private:
     // pillars
     std::vector<std::pair<ThreeBlade, gameplay::PillarType>> m_PillarArray;
     std::vector<gameplay::MovablePillar>  m_Movable;
+    gameplay::SweepAndPrune               m_MovableBroadphase;   // pillar vs pillar, coherent across frames
+    gameplay::MoverScheduler              m_MoverLod;            // which movers step this frame
     std::vector<gameplay::ReflectPillar>  m_Reflectors;
 
+    // baked gravity of the static (Normal) pillars in m_PillarArray
+    gameplay::GravityField m_StaticGravity;   // cell size: LevelParams::gravityCellSize
+
     int   m_CurrentPillarIndex{-1};
     bool  m_AutoRotateActive{true};
     float m_ActiveRotateTimer{0.f};
@@ -95,11 +159,52 @@ private:
     std::mt19937 m_Rng;
 
     // collectibles
-    std::vector<ThreeBlade> m_Collectibles;
-    std::vector<char>       m_Collected;   // 0/1
-    int   m_CollectiblesRemaining{0};
+    std::vector<ThreeBlade>    m_Collectibles;        // as spawned
+    gameplay::CollectibleField m_CollectibleField;    // bucketed copy pickups and drawing use
+    std::vector<uint32_t>      m_Picked;
     float m_CollectibleRadius{10.f};
 
+    // reflectors and the end gate as trigger volumes around the player;
+    // rebuilt before the next step whenever one of them changes
+    enum TriggerTag : uint32_t { kTriggerReflector, kTriggerEndGate };
+    gameplay::TriggerSystem m_Triggers;
+    bool m_TriggersDirty{true};
+
     // maze
     gameplay::Maze m_Maze;
+
+    // maze flow toward the player's cell, followed by Seek pillars
+    gameplay::FlowField m_SeekFlow;
+    ThreeBlade m_SeekGoal{};
+    size_t     m_SeekFlowBudget{256};   // BFS cells expanded per frame
+
+    // level layout + background builder for the upcoming ones; with a seed
+    // from the command line built mazes are kept on disk, so replays skip
+    // generation (random runs never repeat a seed, so they don't write)
+    gameplay::MazeCache     m_MazeCache{"mazecache"};
+    gameplay::LevelParams   m_LevelParams;
+    gameplay::LevelPipeline m_LevelPipeline{2};
+
+    // endless chunked world (toggled with I); camera is the view's bottom-left
+    bool  m_WorldMode{false};
+    gameplay::WorldParams  m_WorldParams;
+    gameplay::ChunkManager m_World;
+    std::vector<std::pair<ThreeBlade, gameplay::PillarType>> m_WorldPillars;
+    float m_CameraX{0.f}, m_CameraY{0.f};
+    float m_CameraFollow{6.f};
+
+    // crowd of passive fish under the same pillar fields
+    gameplay::AgentBatch m_Fish;
+    int   m_FishSpawnCount{2000};
+    gameplay::AgentBatchSim::Stats m_FishStats{};   // reported with the solver stats
+
+    // player wall-contact solver
+    gameplay::ContactStats m_PlayerContacts{};
+
+    // F3: solver stats on the console every few seconds (ReportStats)
+    bool  m_ShowSolverStats{false};
+    float m_StatsReportTimer{0.f};
+
+    // player substeps per frame, reported with the contacts
+    gameplay::SubstepController m_Substeps;
 };
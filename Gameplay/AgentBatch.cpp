@@ -0,0 +1,227 @@
+#include "Gameplay/AgentBatch.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#include "Gameplay/CollisionSystemMaze.h"
+#include "Gameplay/GravityField.h"
+#include "Gameplay/JobSystem.h"
+
+namespace gameplay {
+
+void AgentBatch::Clear()
+{
+    x.clear(); y.clear();
+    vx.clear(); vy.clear();
+    energy.clear();
+    inAx.clear(); inAy.clear();
+    reflectInside.clear();
+}
+
+void AgentBatch::Reserve(size_t n)
+{
+    x.reserve(n); y.reserve(n);
+    vx.reserve(n); vy.reserve(n);
+    energy.reserve(n);
+    inAx.reserve(n); inAy.reserve(n);
+}
+
+void AgentBatch::Add(float px, float py, float pvx, float pvy)
+{
+    x.push_back(px);   y.push_back(py);
+    vx.push_back(pvx); vy.push_back(pvy);
+    energy.push_back(0.f);
+    inAx.push_back(0.f); inAy.push_back(0.f);
+    reflectInside.resize(x.size() * size_t(std::max(reflectorCount, 0)), 0);
+}
+
+// agents are processed in small tiles so the accelerations stay on the stack
+static constexpr size_t kTile = 256;
+
+void AgentBatchSim::StepRange(AgentBatch& b, const Scene& scene,
+                              float dt, const PlayerController::Tuning& k,
+                              size_t begin, size_t end)
+{
+    if (dt <= 0.f) return;
+
+    static const std::vector<ThreeBlade> kNoPillars;
+    static const std::vector<int>        kNoActive;
+    const std::vector<ThreeBlade>& pillars = scene.pillars   ? *scene.pillars   : kNoPillars;
+    const std::vector<int>&        active  = scene.activeSet ? *scene.activeSet : kNoActive;
+
+    const bool useBaked = scene.baked && scene.baked->PillarCount() <= int(pillars.size());
+    const size_t firstExact = useBaked ? size_t(scene.baked->PillarCount()) : 0;
+
+    // drag is the same for every agent this step
+    const float steps   = std::max(0.f, dt * 60.f);
+    const float dragK   = std::pow(k.drag, steps);
+    const float eDragK  = std::pow(k.energyDrag, steps);
+
+    float* px = b.x.data();  float* py = b.y.data();
+    float* pvx = b.vx.data(); float* pvy = b.vy.data();
+    float* pe = b.energy.data();
+
+    for (size_t t0 = begin; t0 < end; t0 += kTile)
+    {
+        const size_t t1 = std::min(end, t0 + kTile);
+        const size_t n  = t1 - t0;
+
+        float ax[kTile], ay[kTile];
+        for (size_t j = 0; j < n; ++j) {
+            ax[j] = b.inAx[t0 + j];
+            ay[j] = b.inAy[t0 + j];
+        }
+
+        // baked static gravity, falls back to the exact sum outside the grid
+        if (useBaked) {
+            for (size_t j = 0; j < n; ++j) {
+                float gx, gy;
+                const size_t i = t0 + j;
+                if (scene.baked->Sample(px[i], py[i], gx, gy)) {
+                    ax[j] += gx; ay[j] += gy;
+                    continue;
+                }
+                for (size_t p = 0; p < firstExact; ++p) {
+                    const float dx = pillars[p][0] - px[i];
+                    const float dy = pillars[p][1] - py[i];
+                    const float R  = std::sqrt(dx*dx + dy*dy);
+                    if (R < 1e-6f) continue;
+                    const float g = k.gravAccel / (std::max(R, k.gravMinR) * R);
+                    ax[j] += g * dx; ay[j] += g * dy;
+                }
+            }
+        }
+
+        // exact gravity: one pillar at a time over the whole tile
+        for (size_t p = firstExact; p < pillars.size(); ++p) {
+            const float cx = pillars[p][0], cy = pillars[p][1];
+            for (size_t j = 0; j < n; ++j) {
+                const float dx = cx - px[t0 + j];
+                const float dy = cy - py[t0 + j];
+                const float R  = std::sqrt(std::max(dx*dx + dy*dy, 1e-12f));
+                const float g  = (R < 1e-6f) ? 0.f : k.gravAccel / (std::max(R, k.gravMinR) * R);
+                ax[j] += g * dx;
+                ay[j] += g * dy;
+            }
+        }
+
+        // swirl around the active pillars, masked instead of branched
+        for (int idx : active) {
+            if (idx < 0 || idx >= int(pillars.size())) continue;
+            const float cx = pillars[size_t(idx)][0], cy = pillars[size_t(idx)][1];
+            const float attachR = k.influenceR;
+
+            for (size_t j = 0; j < n; ++j) {
+                const size_t i = t0 + j;
+                const float dxp = px[i] - cx;
+                const float dyp = py[i] - cy;
+                const float R   = std::sqrt(std::max(dxp*dxp + dyp*dyp, 1e-12f));
+                const float in  = (R < attachR) ? 1.f : 0.f;
+
+                const float invR = 1.f / R;
+                const float rx = dxp * invR, ry = dyp * invR;
+                const float tx = -ry,        ty = +rx;
+
+                const float w  = std::clamp(1.f - R / attachR, 0.f, 1.f);
+                const float spinR = std::max(R, k.minSpinR);
+                float swirlAcc = 2.0f * k.accel * (0.25f + 0.75f * w * w);
+                swirlAcc += k.accel * 0.35f * (k.slingFactor * pe[i]) / spinR;
+
+                const float vt  = pvx[i] * tx + pvy[i] * ty;
+                const float a_c = 0.15f * (vt * vt) / spinR;
+
+                ax[j] += in * (swirlAcc * tx - a_c * rx);
+                ay[j] += in * (swirlAcc * ty - a_c * ry);
+            }
+        }
+
+        // integrate, cap, drag, move
+        for (size_t j = 0; j < n; ++j) {
+            const size_t i = t0 + j;
+            float nvx = pvx[i] + ax[j] * dt;
+            float nvy = pvy[i] + ay[j] * dt;
+
+            const float speed = std::sqrt(nvx*nvx + nvy*nvy);
+            const float s = (speed > k.maxSpeed) ? k.maxSpeed / speed : 1.f;
+            nvx *= s * dragK;
+            nvy *= s * dragK;
+
+            pvx[i] = nvx;
+            pvy[i] = nvy;
+            px[i] += nvx * dt;
+            py[i] += nvy * dt;
+            pe[i] = std::clamp(pe[i] * eDragK, -k.maxEnergy, k.maxEnergy);
+        }
+    }
+
+    // reflectors: half-turn about C on enter, latched until exit
+    if (scene.reflectors && b.reflectorCount == int(scene.reflectors->size())) {
+        const auto& refl = *scene.reflectors;
+        const size_t nr = refl.size();
+        for (size_t r = 0; r < nr; ++r) {
+            const float cx = refl[r].C[0], cy = refl[r].C[1];
+            const float tr2 = refl[r].triggerR * refl[r].triggerR;
+            for (size_t i = begin; i < end; ++i) {
+                const float dx = px[i] - cx, dy = py[i] - cy;
+                const uint8_t inside = (dx*dx + dy*dy <= tr2) ? 1 : 0;
+                uint8_t& was = b.reflectInside[i * nr + r];
+                if (inside && !was) {
+                    px[i] = 2.f * cx - px[i];
+                    py[i] = 2.f * cy - py[i];
+                    pvx[i] = -pvx[i];
+                    pvy[i] = -pvy[i];
+                }
+                was = inside;
+            }
+        }
+    }
+
+    // maze walls, then the world bounds (same rules as the player)
+    for (size_t i = begin; i < end; ++i) {
+        if (scene.maze) {
+            ThreeBlade X(px[i], py[i], 0.f);
+            CollisionSystemMaze::Resolve(*scene.maze, X, pvx[i], pvy[i], b.radius, k.bounceLoss);
+            px[i] = X[0]; py[i] = X[1];
+        }
+
+        if (scene.width > 0.f && scene.height > 0.f) {
+            bool hit = false;
+            if (px[i] < b.radius)                     { px[i] = b.radius;                pvx[i] = -pvx[i] * k.bounceLoss; hit = true; }
+            else if (px[i] > scene.width - b.radius)  { px[i] = scene.width - b.radius;  pvx[i] = -pvx[i] * k.bounceLoss; hit = true; }
+            if (py[i] < b.radius)                     { py[i] = b.radius;                pvy[i] = -pvy[i] * k.bounceLoss; hit = true; }
+            else if (py[i] > scene.height - b.radius) { py[i] = scene.height - b.radius; pvy[i] = -pvy[i] * k.bounceLoss; hit = true; }
+            if (hit) pe[i] += 0.12f * std::sqrt(pvx[i]*pvx[i] + pvy[i]*pvy[i]);
+        }
+    }
+}
+
+AgentBatchSim::Stats AgentBatchSim::Step(AgentBatch& b, const Scene& scene,
+                                         float dt, const PlayerController::Tuning& k,
+                                         JobSystem* jobs)
+{
+    const auto t0 = std::chrono::steady_clock::now();
+
+    // reflector set changed (new level): forget the latches
+    const int nr = scene.reflectors ? int(scene.reflectors->size()) : 0;
+    if (b.reflectorCount != nr) {
+        b.reflectorCount = nr;
+        b.reflectInside.assign(b.Size() * size_t(nr), 0);
+    }
+
+    const size_t count = b.Size();
+    if (!jobs || jobs->WorkerCount() == 0) {
+        StepRange(b, scene, dt, k, 0, count);
+    } else {
+        jobs->ParallelFor(count, kTile, [&](size_t s, size_t e) {
+            StepRange(b, scene, dt, k, s, e);
+        });
+    }
+
+    Stats st;
+    st.agents  = count;
+    st.steps   = 1;
+    st.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    return st;
+}
+
+} // namespace gameplay
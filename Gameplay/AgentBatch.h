@@ -0,0 +1,70 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "../FlyFish.h"
+#include "Gameplay/Maze.h"
+#include "Gameplay/PlayerController.h"
+#include "Gameplay/ReflecPillar.h"
+
+namespace gameplay {
+
+    class GravityField;
+    class JobSystem;
+
+    // Structure-of-arrays crowd of "fish" bodies. Each agent follows the same
+    // rules as the player (gravity, swirl, reflectors, maze walls) but with
+    // its own steering acceleration (inAx/inAy) instead of keyboard input.
+    struct AgentBatch {
+        std::vector<float> x, y;
+        std::vector<float> vx, vy;
+        std::vector<float> energy;
+        std::vector<float> inAx, inAy;   // AI steering, zero for passive fish
+
+        // one byte per (agent, reflector): was the agent inside last step
+        std::vector<uint8_t> reflectInside;
+        int reflectorCount{0};
+
+        float radius{3.f};
+
+        size_t Size() const { return x.size(); }
+        void Clear();
+        void Reserve(size_t n);
+        void Add(float px, float py, float pvx = 0.f, float pvy = 0.f);
+    };
+
+    class AgentBatchSim {
+    public:
+        // everything the agents react to, shared read-only across chunks
+        struct Scene {
+            const Maze* maze = nullptr;
+            const std::vector<ThreeBlade>* pillars = nullptr;
+            const std::vector<int>* activeSet = nullptr;
+            const std::vector<ReflectPillar>* reflectors = nullptr;
+            const GravityField* baked = nullptr;   // see PlayerController::StepKinematics
+            float width = 0.f, height = 0.f;
+        };
+
+        struct Stats {
+            size_t agents = 0;
+            int    steps  = 0;
+            double seconds = 0.0;
+
+            double AgentStepsPerSecond() const {
+                return seconds > 0.0 ? double(agents) * steps / seconds : 0.0;
+            }
+        };
+
+        // Advances every agent by dt. Without a job system everything runs on
+        // the caller, otherwise contiguous chunks go through ParallelFor.
+        static Stats Step(AgentBatch& b, const Scene& scene,
+                          float dt, const PlayerController::Tuning& k,
+                          JobSystem* jobs = nullptr);
+
+        // steps [begin, end) only; chunks never touch each other's agents
+        static void StepRange(AgentBatch& b, const Scene& scene,
+                              float dt, const PlayerController::Tuning& k,
+                              size_t begin, size_t end);
+    };
+
+} // namespace gameplay
@@ -0,0 +1,31 @@
+#include "Gameplay/AgentRenderer.h"
+#include <SDL_opengl.h>
+#include <algorithm>
+#include <cmath>
+
+namespace gameplay {
+
+    void AgentRenderer::Draw(const AgentBatch& batch)
+    {
+        Draw(batch.x, batch.y, batch.energy, batch.radius);
+    }
+
+    void AgentRenderer::Draw(const std::vector<float>& x, const std::vector<float>& y,
+                             const std::vector<float>& energy, float radius)
+    {
+        const size_t n = std::min(x.size(), std::min(y.size(), energy.size()));
+        if (n == 0) return;
+
+        // one point per fish, tinted by its energy like the player ring
+        glPointSize(2.f * radius);
+        glBegin(GL_POINTS);
+        for (size_t i = 0; i < n; ++i) {
+            const float e01 = std::clamp(std::fabs(energy[i]) * 0.01f, 0.f, 1.f);
+            glColor4f(0.3f + 0.7f * e01, 0.7f, 1.f - 0.6f * e01, 0.85f);
+            glVertex2f(x[i], y[i]);
+        }
+        glEnd();
+        glPointSize(1.f);
+    }
+
+} // namespace gameplay
@@ -0,0 +1,13 @@
+#pragma once
+#include "Gameplay/AgentBatch.h"
+
+namespace gameplay {
+
+    class AgentRenderer {
+    public:
+        static void Draw(const AgentBatch& batch);
+        static void Draw(const std::vector<float>& x, const std::vector<float>& y,
+                         const std::vector<float>& energy, float radius);
+    };
+
+} // namespace gameplay
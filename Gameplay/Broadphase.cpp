@@ -0,0 +1,96 @@
+#include "Gameplay/Broadphase.h"
+#include <algorithm>
+
+namespace gameplay {
+
+void SweepAndPrune::Clear()
+{
+    m_Boxes.clear();
+    m_Order.clear();
+    m_SortedMinX.clear();
+    m_MaxWidth = 0.f;
+    m_LastSwaps = 0;
+    m_FullSort = true;
+}
+
+void SweepAndPrune::Resize(size_t n)
+{
+    const size_t old = m_Boxes.size();
+    if (n == old) return;
+
+    m_Boxes.resize(n, Box{0.f, 0.f, 0.f, 0.f});
+    if (n < old) {
+        m_Order.erase(std::remove_if(m_Order.begin(), m_Order.end(),
+                                     [n](uint32_t id) { return id >= n; }),
+                      m_Order.end());
+    } else {
+        for (size_t id = old; id < n; ++id) m_Order.push_back(uint32_t(id));
+        // a handful of new ids sort in fine, a fresh set does not
+        if (n - old > old / 4) m_FullSort = true;
+    }
+}
+
+void SweepAndPrune::Update()
+{
+    auto key = [this](uint32_t id) { return m_Boxes[id].minX; };
+
+    m_LastSwaps = 0;
+    if (m_FullSort) {
+        std::sort(m_Order.begin(), m_Order.end(),
+                  [&](uint32_t a, uint32_t b) { return key(a) < key(b); });
+        m_FullSort = false;
+    } else {
+        // insertion sort: linear when the order barely changed since last frame
+        for (size_t i = 1; i < m_Order.size(); ++i) {
+            const uint32_t id = m_Order[i];
+            const float k = key(id);
+            size_t j = i;
+            while (j > 0 && key(m_Order[j - 1]) > k) {
+                m_Order[j] = m_Order[j - 1];
+                --j;
+            }
+            m_Order[j] = id;
+            m_LastSwaps += i - j;
+        }
+    }
+
+    m_SortedMinX.resize(m_Order.size());
+    m_MaxWidth = 0.f;
+    for (size_t i = 0; i < m_Order.size(); ++i) {
+        const Box& b = m_Boxes[m_Order[i]];
+        m_SortedMinX[i] = b.minX;
+        m_MaxWidth = std::max(m_MaxWidth, b.maxX - b.minX);
+    }
+}
+
+void SweepAndPrune::Pairs(std::vector<std::pair<uint32_t, uint32_t>>& out) const
+{
+    out.clear();
+    const size_t n = m_Order.size();
+    for (size_t i = 0; i < n; ++i) {
+        const uint32_t a = m_Order[i];
+        const Box& A = m_Boxes[a];
+        for (size_t j = i + 1; j < n && m_SortedMinX[j] <= A.maxX; ++j) {
+            const uint32_t b = m_Order[j];
+            const Box& B = m_Boxes[b];
+            if (B.minY > A.maxY || B.maxY < A.minY) continue;
+            out.emplace_back(std::min(a, b), std::max(a, b));
+        }
+    }
+}
+
+void SweepAndPrune::Query(float minX, float minY, float maxX, float maxY,
+                          std::vector<uint32_t>& out) const
+{
+    out.clear();
+    // no box is wider than m_MaxWidth, so nothing starting further left can reach minX
+    auto it = std::lower_bound(m_SortedMinX.begin(), m_SortedMinX.end(), minX - m_MaxWidth);
+    for (size_t i = size_t(it - m_SortedMinX.begin());
+         i < m_SortedMinX.size() && m_SortedMinX[i] <= maxX; ++i) {
+        const Box& B = m_Boxes[m_Order[i]];
+        if (B.maxX < minX || B.minY > maxY || B.maxY < minY) continue;
+        out.push_back(m_Order[i]);
+    }
+}
+
+} // namespace gameplay
@@ -0,0 +1,56 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace gameplay {
+
+    // Sweep-and-prune over axis-aligned boxes, sorted on x.
+    //
+    // Bodies are addressed by id (0..Size()-1) and rewritten every frame with
+    // SetBox/SetCircle; Update then re-sorts. The x order survives between
+    // frames, so for bodies that move a little per step the insertion sort
+    // is close to linear and so is the pair sweep. Walls stay out of it:
+    // each maze already has its own grid (WallGrid/WallSoA), this is for
+    // the things that move - pillars now, the player and agents via Query.
+    class SweepAndPrune {
+    public:
+        struct Box { float minX, minY, maxX, maxY; };
+
+        void Clear();
+        // keeps the order of ids that still exist, new ids go to the end
+        void Resize(size_t n);
+        size_t Size() const { return m_Boxes.size(); }
+
+        void SetBox(uint32_t id, float minX, float minY, float maxX, float maxY) {
+            m_Boxes[id] = Box{minX, minY, maxX, maxY};
+        }
+        void SetCircle(uint32_t id, float x, float y, float r) {
+            m_Boxes[id] = Box{x - r, y - r, x + r, y + r};
+        }
+        const Box& GetBox(uint32_t id) const { return m_Boxes[id]; }
+
+        // sort on minX; call after the boxes are written, before the queries
+        void Update();
+
+        // overlapping (a < b) pairs, ordered by the sweep
+        void Pairs(std::vector<std::pair<uint32_t, uint32_t>>& out) const;
+
+        // ids whose boxes overlap the query box, unordered
+        void Query(float minX, float minY, float maxX, float maxY,
+                   std::vector<uint32_t>& out) const;
+
+        // swaps done by the last Update; ~0 for a coherent scene
+        size_t LastSwaps() const { return m_LastSwaps; }
+
+    private:
+        std::vector<Box>      m_Boxes;      // by id
+        std::vector<uint32_t> m_Order;      // ids sorted on minX
+        std::vector<float>    m_SortedMinX; // minX in m_Order order, for Query
+        float  m_MaxWidth = 0.f;
+        size_t m_LastSwaps = 0;
+        bool   m_FullSort = true;           // order is stale, skip the insertion sort
+    };
+
+} // namespace gameplay
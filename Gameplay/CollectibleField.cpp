@@ -0,0 +1,116 @@
+#include "Gameplay/CollectibleField.h"
+#include <algorithm>
+#include <cmath>
+
+namespace gameplay {
+
+int CollectibleField::CellX(float px) const
+{
+    return std::clamp(int(std::floor((px - originX) / cellSize)), 0, cols - 1);
+}
+
+int CollectibleField::CellY(float py) const
+{
+    return std::clamp(int(std::floor((py - originY) / cellSize)), 0, rows - 1);
+}
+
+void CollectibleField::Clear()
+{
+    cols = rows = 0;
+    cellStart.clear();
+    cellLive.clear();
+    x.clear(); y.clear();
+    index.clear();
+    collected.clear();
+    remaining = 0;
+    ++version;
+}
+
+void CollectibleField::Build(const std::vector<ThreeBlade>& items, float itemRadius, float cell)
+{
+    Clear();
+    radius = itemRadius;
+    if (items.empty()) return;
+
+    float minX = items[0][0], minY = items[0][1], maxX = minX, maxY = minY;
+    for (const auto& P : items) {
+        minX = std::min(minX, P[0]); maxX = std::max(maxX, P[0]);
+        minY = std::min(minY, P[1]); maxY = std::max(maxY, P[1]);
+    }
+
+    cellSize = std::max(cell, 1.f);
+    originX = minX; originY = minY;
+    cols = std::max(1, int((maxX - minX) / cellSize) + 1);
+    rows = std::max(1, int((maxY - minY) / cellSize) + 1);
+
+    const size_t cells = size_t(cols) * size_t(rows);
+    const size_t n = items.size();
+
+    // counting sort into cells
+    std::vector<uint32_t> cellOf(n);
+    cellStart.assign(cells + 1, 0);
+    for (size_t i = 0; i < n; ++i) {
+        cellOf[i] = uint32_t(size_t(CellY(items[i][1])) * size_t(cols) + size_t(CellX(items[i][0])));
+        ++cellStart[cellOf[i] + 1];
+    }
+    for (size_t c = 0; c < cells; ++c) cellStart[c + 1] += cellStart[c];
+
+    x.resize(n); y.resize(n); index.resize(n);
+    std::vector<uint32_t> fill(cellStart.begin(), cellStart.end() - 1);
+    for (size_t i = 0; i < n; ++i) {
+        const uint32_t s = fill[cellOf[i]]++;
+        x[s] = items[i][0];
+        y[s] = items[i][1];
+        index[s] = uint32_t(i);
+    }
+
+    cellLive.resize(cells);
+    for (size_t c = 0; c < cells; ++c) cellLive[c] = cellStart[c + 1] - cellStart[c];
+
+    collected.assign((n + 63) / 64, 0);
+    remaining = n;
+}
+
+size_t CollectibleField::Collect(float px, float py, float r, std::vector<uint32_t>* picked)
+{
+    if (remaining == 0) return 0;
+
+    const float reach = r + radius;
+    const float reach2 = reach * reach;
+    const int x0 = CellX(px - reach), x1 = CellX(px + reach);
+    const int y0 = CellY(py - reach), y1 = CellY(py + reach);
+
+    size_t n = 0;
+    for (int cy = y0; cy <= y1; ++cy) {
+        for (int cx = x0; cx <= x1; ++cx) {
+            const size_t c = size_t(cy) * size_t(cols) + size_t(cx);
+            const uint32_t b = cellStart[c];
+            uint32_t live = cellLive[c];
+            for (uint32_t s = b; s < b + live; ) {
+                const float dx = x[s] - px, dy = y[s] - py;
+                if (dx*dx + dy*dy > reach2) { ++s; continue; }
+
+                // swap with the last live item; slot s is tested again
+                const uint32_t last = b + live - 1;
+                std::swap(x[s], x[last]);
+                std::swap(y[s], y[last]);
+                std::swap(index[s], index[last]);
+                --live;
+
+                const uint32_t i = index[last];
+                collected[i >> 6] |= uint64_t(1) << (i & 63);
+                if (picked) picked->push_back(i);
+                ++n;
+            }
+            cellLive[c] = live;
+        }
+    }
+
+    if (n) {
+        remaining -= n;
+        ++version;
+    }
+    return n;
+}
+
+} // namespace gameplay
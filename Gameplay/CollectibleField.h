@@ -0,0 +1,64 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "../FlyFish.h"
+
+namespace gameplay {
+
+    // Collectibles bucketed on a uniform grid, for levels with thousands of
+    // them ("coin fields").
+    //
+    // Items are stored cell by cell. Within a cell, the first 'live' slots
+    // are still up and the rest are collected: picking one up swaps it with
+    // the cell's last live item. Pickups only walk the cells under the
+    // player and never revisit collected items. The renderer walks the
+    // occupied cells in view. 'collected' is a bitset by the item's
+    // original index, for whoever still thinks in that order.
+    struct CollectibleField {
+        float originX = 0.f, originY = 0.f;
+        float cellSize = 64.f;
+        int   cols = 0, rows = 0;
+        float radius = 10.f;
+
+        std::vector<uint32_t> cellStart;   // cols*rows + 1 offsets into the slots
+        std::vector<uint32_t> cellLive;    // live items at the front of each cell
+        std::vector<float>    x, y;        // per slot, in cell order
+        std::vector<uint32_t> index;       // per slot: original index
+        std::vector<uint64_t> collected;   // bit per original index
+
+        size_t remaining = 0;
+        uint64_t version = 0;              // bumped on every change
+
+        void Build(const std::vector<ThreeBlade>& items, float itemRadius, float cellSize = 64.f);
+        void Clear();
+
+        size_t Size() const { return x.size(); }
+        size_t Remaining() const { return remaining; }
+        bool IsCollected(uint32_t i) const { return (collected[i >> 6] >> (i & 63)) & 1u; }
+
+        // Picks up every live item the circle touches; returns how many and
+        // appends their original indices to 'picked' when given.
+        size_t Collect(float px, float py, float r, std::vector<uint32_t>* picked = nullptr);
+
+        // fn(slotBegin, liveEnd, slotEnd) for every occupied cell touching the box
+        template <class Fn>
+        void ForEachCell(float minX, float minY, float maxX, float maxY, Fn&& fn) const {
+            if (cols == 0) return;
+            const int x0 = CellX(minX), x1 = CellX(maxX);
+            const int y0 = CellY(minY), y1 = CellY(maxY);
+            for (int cy = y0; cy <= y1; ++cy) {
+                for (int cx = x0; cx <= x1; ++cx) {
+                    const size_t c = size_t(cy) * size_t(cols) + size_t(cx);
+                    const uint32_t b = cellStart[c], e = cellStart[c + 1];
+                    if (b != e) fn(b, b + cellLive[c], e);
+                }
+            }
+        }
+
+        int CellX(float px) const;
+        int CellY(float py) const;
+    };
+
+} // namespace gameplay
@@ -1,144 +1,351 @@
-#include "gameplay/CollisionSystemMaze.h"
+#include "Gameplay/CollisionSystemMaze.h"
 #include <algorithm>
 #include <cmath>
+#include <numeric>
+
+#include "Gameplay/MazeQuery.h"
 
 namespace gameplay {
 
-// Push out along normal (nx,ny) by 'push' and reflect velocity with bounce.
-static inline void ResolveHit(ThreeBlade& X, float& vx, float& vy,
-                              float nx, float ny, float push, float bounceLoss)
+// Up to this many walls one vector pass over all of them is cheaper than
+// the grid lookup (cell walk + sort + unique).
+static constexpr size_t kScanWalls = 256;
+
+static inline bool ScanWhole(const Maze& maze)
 {
-    float nlen = std::sqrt(nx*nx + ny*ny);
-    if (nlen < 1e-6f) return;
-    nx /= nlen; ny /= nlen;
-
-    // position correction
-    X = ThreeBlade(X[0] + nx * push, X[1] + ny * push, 0.f);
-
-    // velocity reflection
-    float vdotn = vx * nx + vy * ny;
-    float k = (1.0f + bounceLoss);
-    vx = vx - k * vdotn * nx;
-    vy = vy - k * vdotn * ny;
+    return !maze.soa.Empty() && (maze.soa.count <= kScanWalls || maze.grid.Empty());
 }
 
-void CollisionSystemMaze::Resolve(const Maze& maze,
-                                  ThreeBlade& X,
-                                  float& vx, float& vy,
-                                  float radius,
-                                  float bounceLoss)
+// Candidate walls for a circle of radius <= 'reach' at (px,py): exactly the
+// walls within 'reach' for small mazes, otherwise those whose grid cells
+// touch the box of half-size 'reach' (every wall without a grid). Valid
+// until the next call on the same thread.
+static const std::vector<uint32_t>& NearbyWalls(const Maze& maze, float px, float py, float reach)
 {
-    float px = X[0], py = X[1];
+    thread_local std::vector<uint32_t> s_Near;
+    if (ScanWhole(maze)) {
+        maze.soa.Within(px, py, reach, s_Near);
+    } else if (maze.grid.Empty()) {
+        s_Near.resize(maze.walls.size());
+        std::iota(s_Near.begin(), s_Near.end(), 0u);
+    } else {
+        maze.grid.Query(px - reach, py - reach, px + reach, py + reach, s_Near);
+    }
+    return s_Near;
+}
+
+// Clear of every wall by more than the bilinear error (< 0.71 cell)?
+// Only answers "yes" when the baked field is sure.
+static inline bool SdfClear(const Maze& maze, float px, float py, float radius)
+{
+    float d;
+    return !maze.sdf.Empty() && maze.sdf.SampleDistance(px, py, d) && d > radius + maze.sdf.Cell();
+}
 
-    for (const auto& w : maze.walls)
-    {
-        // closest point on AABB to circle center
-        float qx = std::clamp(px, w.x, w.x + w.w);
-        float qy = std::clamp(py, w.y, w.y + w.h);
-        float dx = px - qx;
-        float dy = py - qy;
-        float d2 = dx*dx + dy*dy;
-
-        // corner hit
-        if (d2 > 0.f && d2 < radius * radius) {
-            float d = std::sqrt(d2);
-            float push = (radius - d);
-            ResolveHit(X, vx, vy, dx, dy, push, bounceLoss);
-            px = X[0]; py = X[1];
-            continue;
+// Manifold solver settings: sweeps per solve, and how well a constraint
+// must hold (velocity in units/s, position in units) to stop early.
+static constexpr int   kSolverIters = 8;
+static constexpr float kVelocityTol = 1e-3f;
+static constexpr float kPositionTol = 1e-3f;
+
+// Projected Gauss-Seidel on v.n_i >= -e * (v0.n_i) for approaching
+// contacts (>= 0 otherwise), with accumulated non-negative impulses. A
+// single contact reproduces the old reflection exactly; a corner hit
+// reflects each axis once instead of once per wall.
+static int SolveVelocity(const std::vector<WallContact>& cs, float& vx, float& vy, float bounceLoss)
+{
+    thread_local std::vector<float> s_Target, s_Lambda;
+    s_Target.resize(cs.size());
+    s_Lambda.assign(cs.size(), 0.f);
+    for (size_t i = 0; i < cs.size(); ++i) {
+        const float vn = vx * cs[i].nx + vy * cs[i].ny;
+        s_Target[i] = vn < 0.f ? -bounceLoss * vn : 0.f;
+    }
+
+    int it = 0;
+    while (it < kSolverIters) {
+        ++it;
+        float worst = 0.f;
+        for (size_t i = 0; i < cs.size(); ++i) {
+            const float vn = vx * cs[i].nx + vy * cs[i].ny;
+            const float lambda = std::max(0.f, s_Lambda[i] + (s_Target[i] - vn));
+            const float dl = lambda - s_Lambda[i];
+            s_Lambda[i] = lambda;
+            vx += dl * cs[i].nx;
+            vy += dl * cs[i].ny;
+            worst = std::max(worst, std::fabs(dl));
         }
+        if (worst <= kVelocityTol) break;
+    }
+    return it;
+}
 
-        // edge hits
-        // horizontal span
-        if (py >= w.y && py <= w.y + w.h) {
-            // left edge
-            float distL = px - w.x;
-            if (distL > -radius && distL < radius) {
-                float push = radius - std::max(distL, 0.f);
-                if (push > 0.f) { ResolveHit(X, vx, vy, 1.f, 0.f, push, bounceLoss); px = X[0]; }
-            }
-            // right edge
-            float distR = (w.x + w.w) - px;
-            if (distR > -radius && distR < radius) {
-                float push = radius - std::max(distR, 0.f);
-                if (push > 0.f) { ResolveHit(X, vx, vy, -1.f, 0.f, push, bounceLoss); px = X[0]; }
-            }
+// Smallest-effort push d with d.n_i >= depth_i + extra for every contact,
+// again by projected Gauss-Seidel (pushes only ever add along a normal).
+static int SolvePosition(const std::vector<WallContact>& cs, float extra, float& ox, float& oy)
+{
+    thread_local std::vector<float> s_Lambda;
+    s_Lambda.assign(cs.size(), 0.f);
+    ox = oy = 0.f;
+
+    int it = 0;
+    while (it < kSolverIters) {
+        ++it;
+        float worst = 0.f;
+        for (size_t i = 0; i < cs.size(); ++i) {
+            const float dn = ox * cs[i].nx + oy * cs[i].ny;
+            const float lambda = std::max(0.f, s_Lambda[i] + (cs[i].depth + extra - dn));
+            const float dl = lambda - s_Lambda[i];
+            s_Lambda[i] = lambda;
+            ox += dl * cs[i].nx;
+            oy += dl * cs[i].ny;
+            worst = std::max(worst, std::fabs(dl));
         }
-        // vertical span
-        if (px >= w.x && px <= w.x + w.w) {
-            // bottom edge
-            float distB = py - w.y;
-            if (distB > -radius && distB < radius) {
-                float push = radius - std::max(distB, 0.f);
-                if (push > 0.f) { ResolveHit(X, vx, vy, 0.f, 1.f, push, bounceLoss); py = X[1]; }
+        if (worst <= kPositionTol) break;
+    }
+    return it;
+}
+
+static inline void Record(ContactStats* stats, size_t contacts, size_t iters)
+{
+    if (!stats) return;
+    stats->solves     += 1;
+    stats->contacts   += contacts;
+    stats->iterations += iters;
+    stats->maxIterations = std::max(stats->maxIterations, iters);
+}
+
+void CollisionSystemMaze::DedupeContacts(const Maze& maze, float cx, float cy,
+                                         std::vector<WallContact>& cs)
+{
+    if (cs.size() < 2) return;
+    const WallSoA& w = maze.soa;
+
+    auto isCornerOf = [&](const WallContact& c, float& qx, float& qy) {
+        qx = std::clamp(cx, w.minX[c.wall], w.maxX[c.wall]);
+        qy = std::clamp(cy, w.minY[c.wall], w.maxY[c.wall]);
+        return (qx != cx && qy != cy);   // clamped on both axes
+    };
+
+    // corner contacts at a seam: the corner is covered by a neighbour
+    size_t n = 0;
+    for (size_t i = 0; i < cs.size(); ++i) {
+        float qx, qy;
+        bool seam = false;
+        if (isCornerOf(cs[i], qx, qy)) {
+            for (size_t j = 0; j < cs.size() && !seam; ++j) {
+                if (j == i) continue;
+                const uint32_t k = cs[j].wall;
+                seam = qx >= w.minX[k] && qx <= w.maxX[k] && qy >= w.minY[k] && qy <= w.maxY[k];
             }
-            // top edge
-            float distT = (w.y + w.h) - py;
-            if (distT > -radius && distT < radius) {
-                float push = radius - std::max(distT, 0.f);
-                if (push > 0.f) { ResolveHit(X, vx, vy, 0.f, -1.f, push, bounceLoss); py = X[1]; }
+        }
+        if (!seam) cs[n++] = cs[i];
+    }
+    cs.resize(n);
+
+    // same face seen through two rectangles: keep the deeper
+    n = 0;
+    for (size_t i = 0; i < cs.size(); ++i) {
+        bool merged = false;
+        for (size_t j = 0; j < n; ++j) {
+            if (cs[i].nx * cs[j].nx + cs[i].ny * cs[j].ny > 0.999f) {
+                if (cs[i].depth > cs[j].depth) cs[j] = cs[i];
+                merged = true;
+                break;
             }
         }
+        if (!merged) cs[n++] = cs[i];
     }
+    cs.resize(n);
+}
+
+// contacts that still need work: gathered, de-duplicated, grazing ones
+// (numerically at the surface) dropped
+static void GatherManifold(const Maze& maze, float px, float py, float radius,
+                           std::vector<WallContact>& out)
+{
+    CollisionSystemMaze::GatherContacts(maze, px, py, radius, out);
+    CollisionSystemMaze::DedupeContacts(maze, px, py, out);
+    out.erase(std::remove_if(out.begin(), out.end(),
+                             [](const WallContact& c) { return c.depth <= kPositionTol; }),
+              out.end());
+}
+
+void CollisionSystemMaze::Resolve(const Maze& maze,
+                                  ThreeBlade& X,
+                                  float& vx, float& vy,
+                                  float radius,
+                                  float bounceLoss,
+                                  ContactStats* stats)
+{
+    float px = X[0], py = X[1];
+    if (SdfClear(maze, px, py, radius)) return;
+
+    thread_local std::vector<WallContact> s_Contacts;
+    GatherManifold(maze, px, py, radius, s_Contacts);
+    if (s_Contacts.empty()) return;
+
+    const size_t contacts = s_Contacts.size();
+    int iters = SolveVelocity(s_Contacts, vx, vy, bounceLoss);
+
+    // the push is linearised at the first position; one re-gather catches
+    // corners whose normal turned and walls the push reached
+    for (int round = 0; round < 2 && !s_Contacts.empty(); ++round) {
+        float ox, oy;
+        iters += SolvePosition(s_Contacts, 0.f, ox, oy);
+        px += ox; py += oy;
+        GatherManifold(maze, px, py, radius, s_Contacts);
+    }
+
+    X = ThreeBlade(px, py, 0.f);
+    Record(stats, contacts, size_t(iters));
 }
 
 void CollisionSystemMaze::DepenetratePosition(const Maze& maze,
                                               ThreeBlade& X,
                                               float radius,
                                               int maxIters,
-                                              float epsilon)
+                                              float epsilon,
+                                              ContactStats* stats)
 {
-    for (int iter = 0; iter < maxIters; ++iter)
-    {
-        bool any = false;
-        float px = X[0], py = X[1];
-
-        for (const auto& w : maze.walls)
-        {
-            // closest point on AABB to circle center
-            float qx = std::clamp(px, w.x, w.x + w.w);
-            float qy = std::clamp(py, w.y, w.y + w.h);
-            float dx = px - qx;
-            float dy = py - qy;
-            float d2 = dx*dx + dy*dy;
-
-            // corner/edge overlap (center outside the box footprint)
-            if (d2 > 0.f && d2 < radius*radius) {
-                float d = std::sqrt(std::max(d2, 1e-12f));
-                float nx = dx / d, ny = dy / d;
-                float push = (radius - d) + epsilon;
-                X = ThreeBlade(px + nx * push, py + ny * push, 0.f);
-                px = X[0]; py = X[1];
-                any = true;
-                continue;
-            }
+    // baked field first: one sample + a push along the gradient per step
+    if (!maze.sdf.Empty()) {
+        for (int iter = 0; iter < maxIters; ++iter) {
+            float d, gx, gy;
+            if (!maze.sdf.Sample(X[0], X[1], d, gx, gy)) break;
+            if (d >= radius + epsilon || (gx == 0.f && gy == 0.f)) break;
+            const float push = radius - d + epsilon;
+            X = ThreeBlade(X[0] + gx * push, X[1] + gy * push, 0.f);
+        }
+        if (SdfClear(maze, X[0], X[1], radius)) return;
+    }
 
-            // center exactly inside the rectangle (common after teleport)
-            // q == p -> d2 == 0. Push along the minimal axis to the nearest side.
-            if (qx == px && qy == py)
-            {
-                float dl = px - w.x;              // to left side
-                float dr = (w.x + w.w) - px;      // to right
-                float db = py - w.y;              // to bottom
-                float dt = (w.y + w.h) - py;      // to top
-
-                float bestPush = 1e9f, nx = 0.f, ny = 0.f;
-
-                if (dl < radius && dl < bestPush) { bestPush = radius - dl; nx = +1.f; ny = 0.f; }
-                if (dr < radius && dr < bestPush) { bestPush = radius - dr; nx = -1.f; ny = 0.f; }
-                if (db < radius && db < bestPush) { bestPush = radius - db; nx = 0.f;  ny = +1.f; }
-                if (dt < radius && dt < bestPush) { bestPush = radius - dt; nx = 0.f;  ny = -1.f; }
-
-                if (bestPush < 1e8f) {
-                    X = ThreeBlade(px + nx * (bestPush + epsilon),
-                                   py + ny * (bestPush + epsilon), 0.f);
-                    px = X[0]; py = X[1];
-                    any = true;
-                }
-            }
+    // exact rectangles for the final contact: gather, solve all at once, repeat
+    thread_local std::vector<WallContact> s_Contacts;
+    float px = X[0], py = X[1];
+    size_t contacts = 0;
+    int iters = 0;
+    for (int round = 0; round < maxIters; ++round) {
+        GatherManifold(maze, px, py, radius, s_Contacts);
+        if (s_Contacts.empty()) break;
+        if (round == 0) contacts = s_Contacts.size();
+
+        float ox, oy;
+        iters += SolvePosition(s_Contacts, epsilon, ox, oy);
+        px += ox; py += oy;
+    }
+
+    X = ThreeBlade(px, py, 0.f);
+    if (contacts) Record(stats, contacts, size_t(iters));
+}
+
+bool CollisionSystemMaze::CircleOverlapsAnyWall(const Maze& maze,
+                                                float cx, float cy, float r)
+{
+    // clearly free: the baked field decides alone
+    if (SdfClear(maze, cx, cy, r)) return false;
+
+    // signed distances against the maze's precomputed boundary lines
+    const std::vector<uint32_t>& near = NearbyWalls(maze, cx, cy, r);
+    return maze.lines.AnyWithin(near.data(), near.size(), ThreeBlade(cx, cy, 0.f), r);
+}
+
+void CollisionSystemMaze::GatherContacts(const Maze& maze, float cx, float cy, float r,
+                                         std::vector<WallContact>& out)
+{
+    out.clear();
+    if (maze.soa.Empty() || SdfClear(maze, cx, cy, r)) return;
+
+    if (ScanWhole(maze)) {
+        maze.soa.CircleContacts(cx, cy, r, out);
+        return;
+    }
+
+    const float r2 = r * r;
+    for (uint32_t wi : NearbyWalls(maze, cx, cy, r)) {
+        const float dx = cx - std::clamp(cx, maze.soa.minX[wi], maze.soa.maxX[wi]);
+        const float dy = cy - std::clamp(cy, maze.soa.minY[wi], maze.soa.maxY[wi]);
+        if (dx*dx + dy*dy <= r2) out.push_back(maze.soa.Contact(wi, cx, cy, r));
+    }
+}
+
+bool CollisionSystemMaze::SweepCircle(const Maze& maze, float x0, float y0, float dx, float dy,
+                                      float radius, SweepHit& hit)
+{
+    if (maze.soa.Empty()) return false;
+
+    // candidates: walls near the swept box
+    const float bx0 = std::min(x0, x0 + dx) - radius, by0 = std::min(y0, y0 + dy) - radius;
+    const float bx1 = std::max(x0, x0 + dx) + radius, by1 = std::max(y0, y0 + dy) + radius;
+    thread_local std::vector<uint32_t> s_Cand;
+    if (ScanWhole(maze)) {
+        s_Cand.clear();
+        for (uint32_t i = 0; i < uint32_t(maze.soa.count); ++i) {
+            if (maze.soa.maxX[i] < bx0 || maze.soa.minX[i] > bx1) continue;
+            if (maze.soa.maxY[i] < by0 || maze.soa.minY[i] > by1) continue;
+            s_Cand.push_back(i);
         }
+    } else {
+        maze.grid.Query(bx0, by0, bx1, by1, s_Cand);
+    }
 
-        if (!any) break; // all clear
+    bool found = false;
+    for (uint32_t wi : s_Cand) {
+        if (hit.t <= 0.f) break;
+        if (MazeQuery::CircleWall(maze, wi, x0, y0, dx, dy, radius, hit.t, hit.nx, hit.ny)) {
+            hit.wall = wi;
+            found = true;
+        }
     }
+    return found;
 }
+
+int CollisionSystemMaze::SweepMove(const Maze* const* mazes, size_t count,
+                                   ThreeBlade& X, float dx, float dy,
+                                   float& vx, float& vy, float radius, float bounceLoss,
+                                   int maxHits)
+{
+    // stop this far short of the surface so the next sweep starts outside
+    constexpr float kSkin = 1e-2f;
+    const float k = 1.0f + bounceLoss;
+
+    float px = X[0], py = X[1];
+    int hits = 0;
+    while (dx != 0.f || dy != 0.f) {
+        SweepHit h;
+        bool any = false;
+        for (size_t m = 0; m < count; ++m)
+            any |= SweepCircle(*mazes[m], px, py, dx, dy, radius, h);
+
+        if (!any) { px += dx; py += dy; break; }
+
+        const float len = std::sqrt(dx*dx + dy*dy);
+        const float back = len > 0.f ? std::min(h.t, kSkin / len) : 0.f;
+        px += dx * (h.t - back);
+        py += dy * (h.t - back);
+
+        // same reflection as Resolve, for the velocity and what's left of the move
+        const float vdotn = vx * h.nx + vy * h.ny;
+        if (vdotn < 0.f) { vx -= k * vdotn * h.nx; vy -= k * vdotn * h.ny; }
+
+        const float rest = 1.f - h.t;
+        dx *= rest; dy *= rest;
+        const float ddotn = dx * h.nx + dy * h.ny;
+        if (ddotn < 0.f) { dx -= k * ddotn * h.nx; dy -= k * ddotn * h.ny; }
+
+        if (++hits >= maxHits) break;
+    }
+
+    X = ThreeBlade(px, py, 0.f);
+    return hits;
+}
+
+int CollisionSystemMaze::SweepMove(const Maze& maze, ThreeBlade& X, float dx, float dy,
+                                   float& vx, float& vy, float radius, float bounceLoss,
+                                   int maxHits)
+{
+    const Maze* one = &maze;
+    return SweepMove(&one, 1, X, dx, dy, vx, vy, radius, bounceLoss, maxHits);
+}
+
 } // namespace gameplay
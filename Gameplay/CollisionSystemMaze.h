@@ -1,20 +1,84 @@
 #pragma once
-#include "gameplay/Maze.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Gameplay/Maze.h"
 
 namespace gameplay {
 
+    // What the contact solver did, summed over calls (Add) for reporting.
+    struct ContactStats {
+        size_t solves = 0;          // calls that found contacts
+        size_t contacts = 0;        // after de-duplication
+        size_t iterations = 0;      // solver sweeps over a manifold
+        size_t maxIterations = 0;   // most sweeps one call needed
+
+        void Add(const ContactStats& o) {
+            solves += o.solves; contacts += o.contacts; iterations += o.iterations;
+            if (o.maxIterations > maxIterations) maxIterations = o.maxIterations;
+        }
+        double AvgIterations() const { return solves ? double(iterations) / double(solves) : 0.0; }
+    };
+
+    // first wall touched along a sweep
+    struct SweepHit {
+        float    t = 1.f;          // fraction of the move, 0..1
+        float    nx = 0.f, ny = 0.f;
+        uint32_t wall = 0;
+    };
+
     struct CollisionSystemMaze {
+        // Gathers every contact of the circle first (shared edges of adjacent
+        // rectangles counted once), then solves them together: restitution
+        // impulses for the velocity, a linearised push-out for the position.
         static void Resolve(const Maze& maze,
                             ThreeBlade& X,
                             float& vx, float& vy,
                             float radius,
-                            float bounceLoss);
+                            float bounceLoss,
+                            ContactStats* stats = nullptr);
 
+        // position only; maxIters caps the gather + solve rounds
         static void DepenetratePosition(const Maze& maze,
                                         ThreeBlade& X,
                                         float radius,
                                         int maxIters = 12,
-                                        float epsilon = 0.5f);
+                                        float epsilon = 0.5f,
+                                        ContactStats* stats = nullptr);
+
+        // circle vs the nearby walls using the maze's precomputed PGA boundary
+        // lines; a centre inside a wall always overlaps
+        static bool CircleOverlapsAnyWall(const Maze& maze, float cx, float cy, float r);
+
+        // Time of impact of a circle moving from (x0,y0) by (dx,dy): walls it
+        // already touches count at t = 0 when the move heads into them.
+        // Only updates 'hit' for a hit earlier than hit.t, so several mazes
+        // can be folded into one query.
+        static bool SweepCircle(const Maze& maze, float x0, float y0, float dx, float dy,
+                                float radius, SweepHit& hit);
+
+        // Moves X by (dx,dy) through the walls of 'mazes', stopping at each
+        // contact and reflecting the velocity and the rest of the move like
+        // Resolve does, up to maxHits contacts (then the move ends there).
+        // Returns the number of contacts.
+        static int SweepMove(const Maze* const* mazes, size_t count,
+                             ThreeBlade& X, float dx, float dy,
+                             float& vx, float& vy, float radius, float bounceLoss,
+                             int maxHits = 4);
+        static int SweepMove(const Maze& maze, ThreeBlade& X, float dx, float dy,
+                             float& vx, float& vy, float radius, float bounceLoss,
+                             int maxHits = 4);
+
+        // every wall the circle touches, ascending wall index; small mazes
+        // are scanned whole with the SIMD kernel, large ones through the grid
+        static void GatherContacts(const Maze& maze, float cx, float cy, float r,
+                                   std::vector<WallContact>& out);
+
+        // Drops contacts that belong to a shared edge: corner contacts whose
+        // corner lies inside another touched wall (a seam, not a real corner)
+        // and contacts with the same normal as a deeper one.
+        static void DedupeContacts(const Maze& maze, float cx, float cy,
+                                   std::vector<WallContact>& contacts);
     };
 
 } // namespace gameplay
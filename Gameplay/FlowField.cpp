@@ -0,0 +1,133 @@
+#include "Gameplay/FlowField.h"
+#include <algorithm>
+#include <cmath>
+
+#include "Gameplay/Maze.h"
+
+namespace gameplay {
+
+static const int kDx[4] = { 0, 1, 0, -1 };
+static const int kDy[4] = { 1, 0, -1, 0 };
+
+bool FlowField::Reset(const Maze& maze)
+{
+    Clear();
+    const size_t cells = size_t(std::max(0, maze.cols)) * size_t(std::max(0, maze.rows));
+    if (cells == 0 || maze.cellWalls.size() != cells) return false;
+
+    m_Cols = maze.cols;     m_Rows = maze.rows;
+    m_OriginX = maze.originX; m_OriginY = maze.originY;
+    m_CellW = maze.cellW;   m_CellH = maze.cellH;
+    m_Walls = maze.cellWalls;
+
+    m_Live.dist.assign(cells, -1);
+    m_Live.dir.assign(cells, -1);
+    m_Work.dist.assign(cells, -1);
+    m_Work.dir.assign(cells, -1);
+    m_Queue.resize(cells);
+    return true;
+}
+
+void FlowField::Clear()
+{
+    m_Cols = m_Rows = 0;
+    m_Walls.clear();
+    m_Live = Buffer{};
+    m_Work = Buffer{};
+    m_Queue.clear();
+    m_Head = m_Tail = 0;
+    m_Pending = false;
+}
+
+bool FlowField::Open(size_t cell, int dir) const
+{
+    const int x = int(cell % size_t(m_Cols)), y = int(cell / size_t(m_Cols));
+    const int nx = x + kDx[dir], ny = y + kDy[dir];
+    if (nx < 0 || ny < 0 || nx >= m_Cols || ny >= m_Rows) return false;
+    return !(m_Walls[cell] & (1u << dir));
+}
+
+void FlowField::Retarget(int tx, int ty)
+{
+    if (Empty()) return;
+    tx = std::clamp(tx, 0, m_Cols - 1);
+    ty = std::clamp(ty, 0, m_Rows - 1);
+
+    // already live or already on its way
+    const Buffer& latest = m_Pending ? m_Work : m_Live;
+    if (latest.tx == tx && latest.ty == ty) return;
+
+    std::fill(m_Work.dist.begin(), m_Work.dist.end(), -1);
+    std::fill(m_Work.dir.begin(), m_Work.dir.end(), int8_t(-1));
+    m_Work.tx = tx; m_Work.ty = ty;
+
+    const uint32_t start = uint32_t(ty) * uint32_t(m_Cols) + uint32_t(tx);
+    m_Work.dist[start] = 0;
+    m_Queue[0] = start;
+    m_Head = 0; m_Tail = 1;
+    m_Pending = true;
+}
+
+bool FlowField::Advance(size_t budget)
+{
+    if (!m_Pending) return true;
+
+    for (; budget > 0 && m_Head < m_Tail; --budget) {
+        const uint32_t c = m_Queue[m_Head++];
+        const int32_t  d = m_Work.dist[c];
+        for (int dir = 0; dir < 4; ++dir) {
+            if (!Open(c, dir)) continue;
+            const uint32_t n = uint32_t(int64_t(c) + kDx[dir] + int64_t(kDy[dir]) * m_Cols);
+            if (m_Work.dist[n] >= 0) continue;
+            m_Work.dist[n] = d + 1;
+            m_Work.dir[n]  = int8_t((dir + 2) & 3);   // from n back toward c
+            m_Queue[m_Tail++] = n;
+        }
+    }
+
+    if (m_Head < m_Tail) return false;
+
+    std::swap(m_Live, m_Work);
+    m_Pending = false;
+    return true;
+}
+
+void FlowField::Build(int tx, int ty)
+{
+    Retarget(tx, ty);
+    Advance(m_Queue.size());
+}
+
+int FlowField::Distance(int cx, int cy) const
+{
+    if (cx < 0 || cy < 0 || cx >= m_Cols || cy >= m_Rows || m_Live.dist.empty()) return -1;
+    return m_Live.dist[size_t(cy) * size_t(m_Cols) + size_t(cx)];
+}
+
+int FlowField::Direction(int cx, int cy) const
+{
+    if (cx < 0 || cy < 0 || cx >= m_Cols || cy >= m_Rows || m_Live.dir.empty()) return -1;
+    return m_Live.dir[size_t(cy) * size_t(m_Cols) + size_t(cx)];
+}
+
+bool FlowField::CellAt(float x, float y, int& cx, int& cy) const
+{
+    if (Empty()) return false;
+    cx = int(std::floor((x - m_OriginX) / m_CellW));
+    cy = int(std::floor((y - m_OriginY) / m_CellH));
+    return cx >= 0 && cy >= 0 && cx < m_Cols && cy < m_Rows;
+}
+
+bool FlowField::NextWaypoint(float x, float y, float& wx, float& wy) const
+{
+    int cx, cy;
+    if (!CellAt(x, y, cx, cy)) return false;
+    const int d = Direction(cx, cy);
+    if (d < 0) return false;
+
+    wx = m_OriginX + (cx + kDx[d] + 0.5f) * m_CellW;
+    wy = m_OriginY + (cy + kDy[d] + 0.5f) * m_CellH;
+    return true;
+}
+
+} // namespace gameplay
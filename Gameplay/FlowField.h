@@ -0,0 +1,64 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace gameplay {
+
+    struct Maze;
+
+    // BFS distance + flow direction toward a target cell over a maze's cell
+    // grid. Anything that wants to follow the maze reads one cell per step
+    // instead of running its own search.
+    //
+    // Retargeting starts a new BFS in a back buffer that Advance() expands a
+    // budget of cells at a time; lookups keep answering from the last
+    // complete field until the new one is done, then the two swap.
+    class FlowField {
+    public:
+        // layout + passability from maze.cellWalls; false if the maze has none
+        bool Reset(const Maze& maze);
+        void Clear();
+        bool Empty() const { return m_Cols == 0; }
+
+        void Retarget(int tx, int ty);
+        // expands up to 'budget' cells; true once the requested target is live
+        bool Advance(size_t budget);
+        void Build(int tx, int ty);
+
+        bool Pending() const { return m_Pending; }
+        int TargetX() const { return m_Live.tx; }
+        int TargetY() const { return m_Live.ty; }
+
+        // steps to the target, -1 when unreached or nothing is built
+        int Distance(int cx, int cy) const;
+        // N=0, E=1, S=2, W=3 toward the target; -1 at the target or unreached
+        int Direction(int cx, int cy) const;
+
+        bool CellAt(float x, float y, int& cx, int& cy) const;
+
+        // centre of the next cell toward the target from world (x,y);
+        // false at the target cell, off the grid or when unreached
+        bool NextWaypoint(float x, float y, float& wx, float& wy) const;
+
+    private:
+        struct Buffer {
+            std::vector<int32_t> dist;
+            std::vector<int8_t>  dir;
+            int tx = -1, ty = -1;
+        };
+
+        bool Open(size_t cell, int dir) const;
+
+        int   m_Cols{0}, m_Rows{0};
+        float m_OriginX{0.f}, m_OriginY{0.f};
+        float m_CellW{1.f}, m_CellH{1.f};
+        std::vector<uint8_t> m_Walls;   // bit d = wall on side d
+
+        Buffer m_Live, m_Work;
+        std::vector<uint32_t> m_Queue;
+        size_t m_Head{0}, m_Tail{0};
+        bool   m_Pending{false};
+    };
+
+} // namespace gameplay
@@ -0,0 +1,55 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "../FlyFish.h"
+#include "Gameplay/CollectibleField.h"
+#include "Gameplay/Maze.h"
+#include "Gameplay/PillarRenderer.h"
+
+namespace gameplay {
+
+    // Immutable copy of everything the renderer needs for one frame.
+    // The sim fills one through a TripleBuffer, the render thread only reads.
+    struct FrameSnapshot {
+        uint64_t frameIndex = 0;
+
+        // bottom-left of the view in world units (0,0 outside world mode)
+        float cameraX = 0.f, cameraY = 0.f;
+
+        // player
+        ThreeBlade character{};
+        float characterRadius = 8.f;
+        float vx = 0.f, vy = 0.f, vzEnergy = 0.f;
+
+        // pillars
+        std::vector<std::pair<ThreeBlade, PillarType>> pillars;
+        int active = -1;
+
+        // maze is shared and only re-copied when its generation changes
+        uint64_t mazeGeneration = 0;
+        std::shared_ptr<const Maze> maze;
+        bool endInSight = false;   // nothing between the player and the end ring
+
+        // world mode: walls of the active tiles (shared, never copied)
+        std::vector<std::shared_ptr<const Maze>> chunkMazes;
+
+        // collectibles: the level's field is shared and only re-copied after
+        // a pickup; world mode fills the flat lists instead
+        std::shared_ptr<const CollectibleField> collectibleField;
+        std::vector<ThreeBlade> collectibles;
+        std::vector<char>       collected;
+        float collectibleRadius = 10.f;
+
+        // fish crowd
+        std::vector<float> fishX, fishY, fishEnergy;
+        float fishRadius = 3.f;
+
+        // HUD
+        float maxSpeed = 220.f;
+        int   collectiblesRemaining = 0;
+    };
+
+} // namespace gameplay
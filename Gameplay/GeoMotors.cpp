@@ -61,4 +61,10 @@ namespace gameplay
         return out.Grade3();
     }
 
+    float GeoMotors::Distance(const ThreeBlade& A, const ThreeBlade& B)
+    {
+        TwoBlade L = A & B;
+        return L.Norm();
+    }
+
 } // namespace gameplay
@@ -11,6 +11,8 @@ namespace gameplay {
         static Motor MakeRotationAboutPoint(const ThreeBlade& C, float angRad);
         static Motor Reverse(const Motor& m);
         static ThreeBlade Apply(const ThreeBlade& X, const Motor& M);
+        // distance between two points: the norm of their joining line
+        static float Distance(const ThreeBlade& A, const ThreeBlade& B);
     };
 
 } // namespace gameplay
@@ -0,0 +1,77 @@
+#include "Gameplay/GravityField.h"
+#include <algorithm>
+#include <cmath>
+
+namespace gameplay {
+
+void GravityField::Build(float width, float height, float cellSize,
+                         float gravAccel, float gravMinR)
+{
+    m_Cell      = std::max(1.f, cellSize);
+    m_InvCell   = 1.f / m_Cell;
+    m_GravAccel = gravAccel;
+    m_GravMinR  = gravMinR;
+
+    m_Nx = std::max(2, int(std::ceil(std::max(0.f, width)  * m_InvCell)) + 1);
+    m_Ny = std::max(2, int(std::ceil(std::max(0.f, height) * m_InvCell)) + 1);
+
+    m_Nodes.assign(size_t(m_Nx) * size_t(m_Ny) * 2, 0.f);
+    m_PillarCount = 0;
+}
+
+void GravityField::Clear()
+{
+    std::fill(m_Nodes.begin(), m_Nodes.end(), 0.f);
+    m_PillarCount = 0;
+}
+
+void GravityField::AddPillar(const ThreeBlade& C)
+{
+    if (m_Nodes.empty()) return;
+
+    // same falloff as PlayerController: g / max(R, minR) toward C
+    for (int j = 0; j < m_Ny; ++j) {
+        for (int i = 0; i < m_Nx; ++i) {
+            const ThreeBlade X(i * m_Cell, j * m_Cell, 0.f);
+            TwoBlade L = X & C;
+            float R = L.Norm();
+            if (R < 1e-6f) continue;
+
+            const float g = m_GravAccel / std::max(R, m_GravMinR);
+            float* n = &m_Nodes[(size_t(j) * m_Nx + i) * 2];
+            n[0] += g * L[3] / R;
+            n[1] += g * L[4] / R;
+        }
+    }
+    ++m_PillarCount;
+}
+
+bool GravityField::Sample(float x, float y, float& ax, float& ay) const
+{
+    if (m_Nodes.empty()) return false;
+
+    const float fx = x * m_InvCell;
+    const float fy = y * m_InvCell;
+    if (fx < 0.f || fy < 0.f || fx > float(m_Nx - 1) || fy > float(m_Ny - 1)) return false;
+
+    const int i0 = std::min(int(fx), m_Nx - 2);
+    const int j0 = std::min(int(fy), m_Ny - 2);
+    const float tx = fx - i0;
+    const float ty = fy - j0;
+
+    const float* a = &m_Nodes[(size_t(j0) * m_Nx + i0) * 2];
+    const float* b = a + 2;
+    const float* c = a + size_t(m_Nx) * 2;
+    const float* d = c + 2;
+
+    const float w00 = (1.f - tx) * (1.f - ty);
+    const float w10 = tx * (1.f - ty);
+    const float w01 = (1.f - tx) * ty;
+    const float w11 = tx * ty;
+
+    ax = a[0] * w00 + b[0] * w10 + c[0] * w01 + d[0] * w11;
+    ay = a[1] * w00 + b[1] * w10 + c[1] * w01 + d[1] * w11;
+    return true;
+}
+
+} // namespace gameplay
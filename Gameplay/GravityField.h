@@ -0,0 +1,39 @@
+#pragma once
+#include <vector>
+#include "../FlyFish.h"
+
+namespace gameplay {
+
+    // Baked gravity of the static pillars over the level.
+    // Stores (ax, ay) on a regular node grid and samples it bilinearly,
+    // so the per-frame cost does not depend on the number of baked pillars.
+    class GravityField {
+    public:
+        void Build(float width, float height, float cellSize,
+                   float gravAccel, float gravMinR);
+
+        // adds one pillar's contribution to every node (incremental rebuild)
+        void AddPillar(const ThreeBlade& C);
+
+        // zeroes the field but keeps the grid layout
+        void Clear();
+
+        // false when (x,y) is outside the baked area or nothing is built
+        bool Sample(float x, float y, float& ax, float& ay) const;
+
+        int PillarCount() const { return m_PillarCount; }
+        bool Empty() const { return m_Nodes.empty(); }
+
+    private:
+        int   m_Nx{0}, m_Ny{0};
+        float m_Cell{16.f};
+        float m_InvCell{1.f / 16.f};
+        float m_GravAccel{220.f};
+        float m_GravMinR{30.f};
+        int   m_PillarCount{0};
+
+        // interleaved ax, ay per node, row-major
+        std::vector<float> m_Nodes;
+    };
+
+} // namespace gameplay
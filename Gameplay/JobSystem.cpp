@@ -0,0 +1,198 @@
+#include "Gameplay/JobSystem.h"
+#include <algorithm>
+
+namespace gameplay {
+
+// index of the queue owned by the current thread, -1 outside the pool
+static thread_local int t_WorkerIndex = -1;
+static thread_local const JobSystem* t_Owner = nullptr;
+
+// --- TaskGraph ---
+
+TaskGraph::NodeId TaskGraph::Add(std::function<void()> fn)
+{
+    auto n = std::make_unique<Node>();
+    n->fn = std::move(fn);
+    m_Nodes.push_back(std::move(n));
+    return NodeId(m_Nodes.size() - 1);
+}
+
+void TaskGraph::Precede(NodeId before, NodeId after)
+{
+    if (before < 0 || after < 0 || before >= int(m_Nodes.size()) || after >= int(m_Nodes.size())) return;
+    m_Nodes[size_t(before)]->successors.push_back(after);
+    m_Nodes[size_t(after)]->dependencies++;
+}
+
+void TaskGraph::Clear()
+{
+    m_Nodes.clear();
+}
+
+// --- JobSystem ---
+
+JobSystem::JobSystem(int workers)
+{
+    if (workers < 0) {
+        const unsigned hw = std::thread::hardware_concurrency();
+        workers = hw > 1 ? int(hw) - 1 : 0;
+    }
+
+    // queues [0, workers) belong to the workers, the last one takes jobs
+    // submitted from threads outside the pool
+    for (int i = 0; i <= workers; ++i)
+        m_Queues.push_back(std::make_unique<Queue>());
+
+    m_Threads.reserve(size_t(workers));
+    for (int i = 0; i < workers; ++i)
+        m_Threads.emplace_back([this, i] { WorkerLoop(i); });
+}
+
+JobSystem::~JobSystem()
+{
+    {
+        std::lock_guard<std::mutex> lk(m_SleepMutex);
+        m_Stop = true;
+    }
+    m_SleepCv.notify_all();
+    for (auto& t : m_Threads) t.join();
+}
+
+void JobSystem::Submit(std::function<void()> fn, std::atomic<int>& counter)
+{
+    counter.fetch_add(1, std::memory_order_relaxed);
+
+    int q = (t_Owner == this) ? t_WorkerIndex : int(m_Queues.size()) - 1;
+    if (q < 0) q = int(m_Queues.size()) - 1;
+
+    {
+        std::lock_guard<std::mutex> lk(m_Queues[size_t(q)]->m);
+        m_Queues[size_t(q)]->jobs.push_back(Job{ std::move(fn), &counter });
+    }
+    m_Queued.fetch_add(1, std::memory_order_release);
+
+    // pass through the sleep lock so a worker between its check and its wait
+    // cannot miss this notification
+    { std::lock_guard<std::mutex> lk(m_SleepMutex); }
+    m_SleepCv.notify_one();
+}
+
+void JobSystem::Wait(const std::atomic<int>& counter)
+{
+    const int self = (t_Owner == this) ? t_WorkerIndex : int(m_Queues.size()) - 1;
+    while (counter.load(std::memory_order_acquire) > 0) {
+        if (!TryRunOne(self)) std::this_thread::yield();
+    }
+}
+
+void JobSystem::ParallelFor(size_t count, size_t grain,
+                            const std::function<void(size_t, size_t)>& fn)
+{
+    if (count == 0) return;
+
+    // a few chunks per thread so stealing can even out uneven work
+    const size_t threads = size_t(WorkerCount()) + 1;
+    const size_t target  = (count + threads * 4 - 1) / (threads * 4);
+    const size_t chunk   = std::max(std::max<size_t>(grain, 1), target);
+
+    if (chunk >= count) { fn(0, count); return; }
+
+    std::atomic<int> counter{0};
+    for (size_t b = chunk; b < count; b += chunk) {
+        const size_t e = std::min(count, b + chunk);
+        Submit([&fn, b, e] { fn(b, e); }, counter);
+    }
+    fn(0, chunk);
+    Wait(counter);
+}
+
+void JobSystem::Run(TaskGraph& graph)
+{
+    if (graph.m_Nodes.empty()) return;
+
+    std::atomic<int> counter{0};
+    for (auto& n : graph.m_Nodes)
+        n->remaining.store(n->dependencies, std::memory_order_relaxed);
+
+    for (size_t i = 0; i < graph.m_Nodes.size(); ++i) {
+        if (graph.m_Nodes[i]->dependencies == 0)
+            Submit([this, &graph, &counter, i] { RunNode(graph, TaskGraph::NodeId(i), counter); }, counter);
+    }
+    Wait(counter);
+}
+
+void JobSystem::RunNode(TaskGraph& graph, TaskGraph::NodeId id, std::atomic<int>& counter)
+{
+    auto& node = *graph.m_Nodes[size_t(id)];
+    if (node.fn) node.fn();
+
+    // release successors before this job's own counter drops
+    for (TaskGraph::NodeId s : node.successors) {
+        if (graph.m_Nodes[size_t(s)]->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            Submit([this, &graph, &counter, s] { RunNode(graph, s, counter); }, counter);
+    }
+}
+
+void JobSystem::WorkerLoop(int index)
+{
+    t_WorkerIndex = index;
+    t_Owner = this;
+
+    while (!m_Stop.load(std::memory_order_acquire)) {
+        if (TryRunOne(index)) continue;
+
+        std::unique_lock<std::mutex> lk(m_SleepMutex);
+        m_SleepCv.wait(lk, [this] {
+            return m_Stop.load(std::memory_order_acquire) ||
+                   m_Queued.load(std::memory_order_acquire) > 0;
+        });
+    }
+}
+
+bool JobSystem::TryRunOne(int self)
+{
+    Job job;
+    if (PopOwn(self, job) || Steal(self, job)) {
+        Execute(job);
+        return true;
+    }
+    return false;
+}
+
+bool JobSystem::PopOwn(int self, Job& out)
+{
+    if (self < 0 || self >= int(m_Queues.size())) return false;
+    Queue& q = *m_Queues[size_t(self)];
+    std::lock_guard<std::mutex> lk(q.m);
+    if (q.jobs.empty()) return false;
+    out = std::move(q.jobs.back());
+    q.jobs.pop_back();
+    m_Queued.fetch_sub(1, std::memory_order_acq_rel);
+    return true;
+}
+
+bool JobSystem::Steal(int self, Job& out)
+{
+    const int n = int(m_Queues.size());
+    const int start = int(m_NextQueue.fetch_add(1, std::memory_order_relaxed) % unsigned(n));
+    for (int k = 0; k < n; ++k) {
+        const int v = (start + k) % n;
+        if (v == self) continue;
+        Queue& q = *m_Queues[size_t(v)];
+        std::lock_guard<std::mutex> lk(q.m);
+        if (q.jobs.empty()) continue;
+        out = std::move(q.jobs.front());
+        q.jobs.pop_front();
+        m_Queued.fetch_sub(1, std::memory_order_acq_rel);
+        return true;
+    }
+    return false;
+}
+
+void JobSystem::Execute(Job& job)
+{
+    if (job.fn) job.fn();
+    if (job.counter) job.counter->fetch_sub(1, std::memory_order_acq_rel);
+}
+
+} // namespace gameplay
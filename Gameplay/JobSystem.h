@@ -0,0 +1,95 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace gameplay {
+
+    class JobSystem;
+
+    // Small dependency graph of tasks, rebuilt or reused every frame.
+    // Nodes run as soon as all of their predecessors have finished.
+    class TaskGraph {
+    public:
+        using NodeId = int;
+
+        NodeId Add(std::function<void()> fn);
+        void Precede(NodeId before, NodeId after);   // 'after' waits for 'before'
+        void Clear();
+
+        size_t Size() const { return m_Nodes.size(); }
+
+    private:
+        friend class JobSystem;
+
+        struct Node {
+            std::function<void()> fn;
+            std::vector<NodeId>   successors;
+            int                   dependencies = 0;
+            std::atomic<int>      remaining{0};
+        };
+
+        std::vector<std::unique_ptr<Node>> m_Nodes;
+    };
+
+    // Work-stealing thread pool. Every worker owns a deque: it pushes and pops
+    // at the back, idle workers steal from the front of the others. Threads
+    // that wait for work (including the main thread) run jobs while waiting,
+    // so nested ParallelFor calls and a pool with zero workers both work.
+    class JobSystem {
+    public:
+        // workers < 0 -> hardware threads minus one (the caller also works)
+        explicit JobSystem(int workers = -1);
+        ~JobSystem();
+
+        JobSystem(const JobSystem&) = delete;
+        JobSystem& operator=(const JobSystem&) = delete;
+
+        int WorkerCount() const { return int(m_Threads.size()); }
+
+        // counter is incremented now and decremented when the job finishes
+        void Submit(std::function<void()> fn, std::atomic<int>& counter);
+        void Wait(const std::atomic<int>& counter);
+
+        // fn(begin, end) over [0, count) in chunks of at least 'grain'
+        void ParallelFor(size_t count, size_t grain,
+                         const std::function<void(size_t, size_t)>& fn);
+
+        // runs the whole graph and returns when every node has finished
+        void Run(TaskGraph& graph);
+
+    private:
+        struct Job {
+            std::function<void()> fn;
+            std::atomic<int>*     counter = nullptr;
+        };
+
+        struct Queue {
+            std::mutex      m;
+            std::deque<Job> jobs;
+        };
+
+        void WorkerLoop(int index);
+        bool TryRunOne(int self);
+        bool PopOwn(int self, Job& out);
+        bool Steal(int self, Job& out);
+        void Execute(Job& job);
+        void RunNode(TaskGraph& graph, TaskGraph::NodeId id, std::atomic<int>& counter);
+
+        std::vector<std::unique_ptr<Queue>> m_Queues;   // one per worker + one for outside threads
+        std::vector<std::thread>            m_Threads;
+
+        std::mutex              m_SleepMutex;
+        std::condition_variable m_SleepCv;
+        std::atomic<int>        m_Queued{0};
+        std::atomic<bool>       m_Stop{false};
+        std::atomic<unsigned>   m_NextQueue{0};
+    };
+
+} // namespace gameplay
@@ -0,0 +1,243 @@
+#include "Gameplay/LevelBuilder.h"
+#include <algorithm>
+#include <cmath>
+
+#include "Gameplay/CollisionSystemMaze.h"
+#include "Gameplay/GeoMotors.h"
+#include "Gameplay/MazeCache.h"
+#include "Gameplay/MazeGenerator.h"
+#include "Gameplay/Placement.h"
+#include "Gameplay/PlayerController.h"
+
+namespace gameplay {
+
+LevelData LevelBuilder::Build(const LevelParams& p, uint32_t seed)
+{
+    LevelData lvl;
+    lvl.seed = seed;
+
+    std::mt19937 rng(seed);
+
+    if (p.mazeCache && seed != 0) {
+        MazeKey key;
+        key.cols = p.cols;          key.rows = p.rows;
+        key.margin = p.mazeMargin;  key.wallThickness = p.wallThickness;
+        key.width = p.width;        key.height = p.height;
+        key.seed = seed;
+        key.mergeWalls  = p.mergeWalls;
+        key.flowToEnd   = p.flowToEnd;
+        key.sdfCellSize = p.sdfCellSize;
+        p.mazeCache->LoadOrGenerate(key, lvl.maze);
+    } else {
+        MazeGenerator::Options mopts;
+        mopts.mergeWalls = p.mergeWalls;
+        mopts.flowToEnd  = p.flowToEnd;
+        mopts.sdfCellSize = p.sdfCellSize;
+        MazeGenerator::Generate(lvl.maze, p.cols, p.rows, p.mazeMargin, p.wallThickness,
+                                p.width, p.height, seed, mopts);
+    }
+
+    SpawnPillars(rng, p, lvl.pillars, lvl.movable, lvl.reflectors);
+    SpawnCollectibles(rng, p, lvl.maze, lvl.collectibles);
+    BakeStaticGravity(p, lvl.pillars, lvl.staticGravity);
+    return lvl;
+}
+
+void LevelBuilder::SpawnPillars(std::mt19937& rng, const LevelParams& p,
+                                std::vector<std::pair<ThreeBlade, PillarType>>& pillars,
+                                std::vector<MovablePillar>& movable,
+                                std::vector<ReflectPillar>& reflectors)
+{
+    // wipe existing
+    pillars.clear();
+    movable.clear();
+    reflectors.clear();
+
+    const float margin = p.pillarMargin;
+    std::uniform_int_distribution<int>   count(0, p.pillarsPerType);
+    std::uniform_real_distribution<float> xDist(margin, p.width  - margin);
+    std::uniform_real_distribution<float> yDist(margin, p.height - margin);
+
+    // params
+    std::uniform_real_distribution<float> speedDist(40.f, 120.f);
+    std::uniform_real_distribution<float> omegaDist(-1.8f, 1.8f);
+    std::uniform_real_distribution<float> orbitRDist(80.f, 160.f);
+    std::uniform_real_distribution<float> maxSpeedDist(100.f, 180.f);
+    std::uniform_real_distribution<float> accelDist(250.f, 480.f);
+    std::uniform_real_distribution<float> triggerDist(70.f, 140.f);
+
+    const int nNormal  = count(rng);
+    const int nMovable = count(rng);
+    const int nLinear  = count(rng);
+    const int nSeek    = count(rng);
+    const int nReflect = count(rng);
+
+    // unit dir from join
+    auto unitDirFromJoin = [&](const ThreeBlade& P, float& ux, float& uy)
+    {
+        for (int tries = 0; tries < 16; ++tries) {
+            ThreeBlade Q(xDist(rng), yDist(rng), 0.f);
+            TwoBlade  L = P & Q;
+            float dx = L[3], dy = L[4];
+            float n2 = dx*dx + dy*dy;
+            if (n2 > 1e-8f) {
+                float inv = 1.0f / std::sqrt(n2);
+                ux = dx * inv; uy = dy * inv;
+                return true;
+            }
+        }
+        ux = 1.f; uy = 0.f;
+        return false;
+    };
+
+    // Normal static pillars (white)
+    for (int i = 0; i < nNormal; ++i) {
+        ThreeBlade c(xDist(rng), yDist(rng), 0.f);
+        pillars.emplace_back(c, PillarType::Normal);
+    }
+
+    // Movable (orbit)
+    for (int i = 0; i < nMovable; ++i) {
+        ThreeBlade anchor(xDist(rng), yDist(rng), 0.f);
+        float ux, uy; unitDirFromJoin(anchor, ux, uy);
+        float R = orbitRDist(rng);
+
+        Motor T = GeoMotors::MakeTranslator(R * ux, R * uy);
+        ThreeBlade start = GeoMotors::Apply(anchor, T);
+
+        float w = omegaDist(rng);
+        movable.push_back(MovablePillar::MakeOrbit(anchor, start, w, 240.f));
+    }
+
+    // Linear movers
+    for (int i = 0; i < nLinear; ++i) {
+        ThreeBlade S(xDist(rng), yDist(rng), 0.f);
+        float ux, uy; unitDirFromJoin(S, ux, uy);
+        float s = speedDist(rng);
+        movable.push_back(MovablePillar::MakeLinear(S, s * ux, s * uy, 240.f));
+    }
+
+    // Seekers
+    for (int i = 0; i < nSeek; ++i) {
+        ThreeBlade start (xDist(rng), yDist(rng), 0.f);
+        ThreeBlade target(xDist(rng), yDist(rng), 0.f);
+        float ms = maxSpeedDist(rng);
+        float ac = accelDist(rng);
+        movable.push_back(MovablePillar::MakeSeek(start, target, ms, ac, 240.f));
+    }
+
+    // Reflectors
+    for (int i = 0; i < nReflect; ++i) {
+        float x = xDist(rng), y = yDist(rng);
+        float tr = triggerDist(rng);
+        reflectors.push_back(ReflectPillar::Make(ThreeBlade(x, y, 0.f), tr));
+    }
+}
+
+void LevelBuilder::SpawnCollectibles(std::mt19937& rng, const LevelParams& p,
+                                     const Maze& maze,
+                                     std::vector<ThreeBlade>& out)
+{
+    int minCount = p.collectiblesMin, maxCount = p.collectiblesMax;
+    if (minCount > maxCount) std::swap(minCount, maxCount);
+
+    std::uniform_int_distribution<int> nDist(minCount, maxCount);
+    PlaceCollectibles(rng, p, maze, nDist(rng), out);
+}
+
+void LevelBuilder::PlaceCollectibles(std::mt19937& rng, const LevelParams& p,
+                                     const Maze& maze, int n,
+                                     std::vector<ThreeBlade>& out)
+{
+    const float radius = p.collectibleRadius;
+
+    Placement::Request req;
+    req.count   = n;
+    req.radius  = radius;
+    req.spacing = 2.0f * radius + 8.f;
+    req.pad     = 2.0f;
+    req.avoid.emplace_back(maze.startCenter, radius + 20.f);
+    req.avoid.emplace_back(maze.endCenter,   radius + maze.endRadius + 10.f);
+
+    if (!Placement::Scatter(rng, maze, req, out))
+        PlaceCollectiblesRejection(rng, p, maze, n, out);
+}
+
+void LevelBuilder::PlaceCollectiblesRejection(std::mt19937& rng, const LevelParams& p,
+                                              const Maze& maze, int n,
+                                              std::vector<ThreeBlade>& out)
+{
+    out.clear();
+
+    const float margin = p.collectibleMargin;
+    const float radius = p.collectibleRadius;
+    std::uniform_real_distribution<float> xDist(margin, p.width  - margin);
+    std::uniform_real_distribution<float> yDist(margin, p.height - margin);
+
+    out.reserve(size_t(std::max(n, 0)));
+
+    const float sep = 2.0f * radius + 8.f;   // min spacing between collectibles
+    const float pad = 2.0f;                  // tiny padding from walls
+
+    for (int i = 0; i < n; ++i) {
+        ThreeBlade c(0.f, 0.f, 0.f);
+        bool placed = false;
+
+        for (int tries = 0; tries < 128 && !placed; ++tries) {
+            float x = xDist(rng), y = yDist(rng);
+            ThreeBlade cand(x, y, 0.f);
+
+            if (CollisionSystemMaze::CircleOverlapsAnyWall(maze, x, y, radius + pad)) continue;
+
+            if (GeoMotors::Distance(cand, maze.startCenter) < (radius + 20.f)) continue;
+            if (GeoMotors::Distance(cand, maze.endCenter)   < (radius + maze.endRadius + 10.f)) continue;
+
+            bool ok = true;
+            for (const auto& other : out) {
+                if (GeoMotors::Distance(cand, other) < sep) { ok = false; break; }
+            }
+            if (!ok) continue;
+
+            c = cand;
+            placed = true;
+        }
+
+        if (!placed) {
+            // fallback -> scan outward a bit around start center until free
+            float sx = maze.startCenter[0], sy = maze.startCenter[1];
+            for (int k = 0; k < 64 && !placed; ++k) {
+                float dx = (k % 16) * 6.f;
+                float dy = (k / 16) * 6.f;
+                float x = std::clamp(sx + dx, margin, p.width  - margin);
+                float y = std::clamp(sy + dy, margin, p.height - margin);
+                if (!CollisionSystemMaze::CircleOverlapsAnyWall(maze, x, y, radius + pad)) {
+                    c = ThreeBlade(x, y, 0.f);
+                    placed = true;
+                }
+            }
+            if (!placed) {
+                // drop anywhere (still check walls)
+                float x = xDist(rng), y = yDist(rng);
+                if (CollisionSystemMaze::CircleOverlapsAnyWall(maze, x, y, radius + pad)) {
+                    // nudge out by a tiny epsilon
+                    x += 2.f; y += 2.f;
+                }
+                c = ThreeBlade(x, y, 0.f);
+            }
+        }
+
+        out.push_back(c);
+    }
+}
+
+void LevelBuilder::BakeStaticGravity(const LevelParams& p,
+                                     const std::vector<std::pair<ThreeBlade, PillarType>>& pillars,
+                                     GravityField& out)
+{
+    const PlayerController::Tuning tune{};
+    out.Build(p.width, p.height, p.gravityCellSize, tune.gravAccel, tune.gravMinR);
+    for (const auto& [C, T] : pillars)
+        out.AddPillar(C);
+}
+
+} // namespace gameplay
@@ -0,0 +1,82 @@
+#pragma once
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "../FlyFish.h"
+#include "Gameplay/GravityField.h"
+#include "Gameplay/Maze.h"
+#include "Gameplay/MovablePillar.h"
+#include "Gameplay/PillarRenderer.h"
+#include "Gameplay/ReflecPillar.h"
+
+namespace gameplay {
+
+    class MazeCache;
+
+    struct LevelParams {
+        // maze
+        int   cols = 14, rows = 10;
+        float mazeMargin = 80.f;
+        float wallThickness = 20.f;
+        float width = 1280.f, height = 720.f;
+        bool  mergeWalls = true;
+        bool  flowToEnd = true;
+        float sdfCellSize = 8.f;
+        // optional: reuse mazes already built for the same layout + seed
+        MazeCache* mazeCache = nullptr;
+
+        // pillars
+        int   pillarsPerType = 2;
+        float pillarMargin = 80.f;
+
+        // collectibles
+        int   collectiblesMin = 2, collectiblesMax = 5;
+        float collectibleMargin = 60.f;
+        float collectibleRadius = 10.f;
+
+        float gravityCellSize = 16.f;
+    };
+
+    // Everything that makes up one playable level, built without touching Game.
+    struct LevelData {
+        uint32_t seed = 0;
+        Maze maze;
+        std::vector<std::pair<ThreeBlade, PillarType>> pillars;   // static (Normal)
+        std::vector<MovablePillar> movable;
+        std::vector<ReflectPillar> reflectors;
+        std::vector<ThreeBlade>    collectibles;
+        GravityField staticGravity;
+    };
+
+    struct LevelBuilder {
+        // full level from a seed; safe to call from any thread
+        static LevelData Build(const LevelParams& p, uint32_t seed);
+
+        static void SpawnPillars(std::mt19937& rng, const LevelParams& p,
+                                 std::vector<std::pair<ThreeBlade, PillarType>>& pillars,
+                                 std::vector<MovablePillar>& movable,
+                                 std::vector<ReflectPillar>& reflectors);
+
+        static void SpawnCollectibles(std::mt19937& rng, const LevelParams& p,
+                                      const Maze& maze,
+                                      std::vector<ThreeBlade>& out);
+
+        // up to n collectibles from the maze's free cell interiors (Placement);
+        // falls back to rejection sampling for mazes without a cell layout
+        static void PlaceCollectibles(std::mt19937& rng, const LevelParams& p,
+                                      const Maze& maze, int n,
+                                      std::vector<ThreeBlade>& out);
+
+        // random points over the window, rejected against walls and each other
+        static void PlaceCollectiblesRejection(std::mt19937& rng, const LevelParams& p,
+                                               const Maze& maze, int n,
+                                               std::vector<ThreeBlade>& out);
+
+        static void BakeStaticGravity(const LevelParams& p,
+                                      const std::vector<std::pair<ThreeBlade, PillarType>>& pillars,
+                                      GravityField& out);
+    };
+
+} // namespace gameplay
@@ -0,0 +1,115 @@
+#include "Gameplay/LevelPipeline.h"
+#include <algorithm>
+
+namespace gameplay {
+
+LevelPipeline::LevelPipeline(size_t capacity)
+    : m_Capacity{ std::max<size_t>(1, capacity) }
+{
+}
+
+LevelPipeline::~LevelPipeline()
+{
+    Stop();
+}
+
+void LevelPipeline::Start(const LevelParams& params, uint32_t seed)
+{
+    Stop();
+
+    if (seed == 0) {
+        std::random_device rd;
+        seed = rd();
+    }
+
+    std::lock_guard<std::mutex> lk(m_Mutex);
+    m_Params = params;
+    m_SeedRng.seed(seed);
+    m_Ready.clear();
+    m_Stop = false;
+    m_Worker = std::thread([this] { WorkerLoop(); });
+}
+
+void LevelPipeline::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lk(m_Mutex);
+        m_Stop = true;
+    }
+    m_Cv.notify_all();
+    if (m_Worker.joinable()) m_Worker.join();
+}
+
+bool LevelPipeline::TryPop(LevelData& out)
+{
+    {
+        std::lock_guard<std::mutex> lk(m_Mutex);
+        if (m_Ready.empty()) return false;
+        out = std::move(m_Ready.front());
+        m_Ready.pop_front();
+    }
+    m_Cv.notify_all();
+    return true;
+}
+
+LevelData LevelPipeline::Pop()
+{
+    LevelParams params;
+    uint32_t seed = 0;
+    {
+        std::unique_lock<std::mutex> lk(m_Mutex);
+        // with the worker running an empty queue means it's building the
+        // next seed right now; wait for it rather than skip ahead
+        m_Cv.wait(lk, [this] { return m_Stop || !m_Ready.empty(); });
+        if (!m_Ready.empty()) {
+            LevelData out = std::move(m_Ready.front());
+            m_Ready.pop_front();
+            lk.unlock();
+            m_Cv.notify_all();
+            return out;
+        }
+        params = m_Params;
+        seed = NextSeed();
+    }
+    return LevelBuilder::Build(params, seed);
+}
+
+size_t LevelPipeline::ReadyCount() const
+{
+    std::lock_guard<std::mutex> lk(m_Mutex);
+    return m_Ready.size();
+}
+
+void LevelPipeline::WorkerLoop()
+{
+    for (;;) {
+        LevelParams params;
+        uint32_t seed = 0;
+        {
+            std::unique_lock<std::mutex> lk(m_Mutex);
+            m_Cv.wait(lk, [this] { return m_Stop || m_Ready.size() < m_Capacity; });
+            if (m_Stop) return;
+            params = m_Params;
+            seed = NextSeed();
+        }
+
+        // the expensive part runs without the lock
+        LevelData lvl = LevelBuilder::Build(params, seed);
+
+        {
+            std::lock_guard<std::mutex> lk(m_Mutex);
+            if (m_Stop) return;
+            m_Ready.push_back(std::move(lvl));
+        }
+        m_Cv.notify_all();
+    }
+}
+
+uint32_t LevelPipeline::NextSeed()
+{
+    uint32_t seed = 0;
+    do { seed = m_SeedRng(); } while (seed == 0);   // 0 would mean random_device
+    return seed;
+}
+
+} // namespace gameplay
@@ -0,0 +1,51 @@
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <random>
+#include <thread>
+
+#include "Gameplay/LevelBuilder.h"
+
+namespace gameplay {
+
+    // Builds upcoming levels on a worker thread while the current one is
+    // played. Keeps up to 'capacity' finished levels ready so that reaching
+    // the end (or restarting) only has to move one in.
+    class LevelPipeline {
+    public:
+        explicit LevelPipeline(size_t capacity = 2);
+        ~LevelPipeline();
+
+        LevelPipeline(const LevelPipeline&) = delete;
+        LevelPipeline& operator=(const LevelPipeline&) = delete;
+
+        // seed == 0 picks a random_device seed for the level sequence
+        void Start(const LevelParams& params, uint32_t seed = 0);
+        void Stop();
+
+        // non-blocking; false when nothing is ready yet
+        bool TryPop(LevelData& out);
+        // next level of the seed sequence: waits for the one being built
+        // when none is ready, builds it here when the worker isn't running,
+        // so the order never depends on how far the worker got
+        LevelData Pop();
+        size_t ReadyCount() const;
+
+    private:
+        void WorkerLoop();
+        uint32_t NextSeed();   // m_Mutex held
+
+        LevelParams  m_Params;
+        size_t       m_Capacity;
+        std::mt19937 m_SeedRng;
+
+        std::thread             m_Worker;
+        mutable std::mutex      m_Mutex;
+        std::condition_variable m_Cv;
+        std::deque<LevelData>   m_Ready;
+        bool                    m_Stop{true};
+    };
+
+} // namespace gameplay
@@ -3,3 +3,36 @@
 //
 
 #include "Maze.h"
+#include <algorithm>
+
+namespace gameplay {
+
+    void Maze::BuildAccel()
+    {
+        soa.Build(walls);
+        lines.Build(walls);
+
+        if (cols > 0 && rows > 0 && cellW > 0.f && cellH > 0.f) {
+            grid.Build(walls, originX, originY, cellW, cellH, cols, rows);
+        } else {
+            grid.BuildUniform(walls, std::max(32.f, 4.f * wallThickness));
+        }
+
+        if (sdfCellSize > 0.f) sdf.Build(walls, sdfCellSize);
+        else sdf.Clear();
+    }
+
+    bool Maze::CellInterior(int cx, int cy, float inset,
+                            float& x0, float& y0, float& x1, float& y1) const
+    {
+        if (cx < 0 || cy < 0 || cx >= cols || cy >= rows) return false;
+
+        const float edge = 0.5f * wallThickness + inset;
+        x0 = originX + cx * cellW + edge;
+        y0 = originY + cy * cellH + edge;
+        x1 = originX + (cx + 1) * cellW - edge;
+        y1 = originY + (cy + 1) * cellH - edge;
+        return x1 >= x0 && y1 >= y0;
+    }
+
+} // namespace gameplay
@@ -1,6 +1,12 @@
 #pragma once
+#include <cstdint>
 #include <vector>
 #include "FlyFish.h"
+#include "Gameplay/FlowField.h"
+#include "Gameplay/WallGrid.h"
+#include "Gameplay/WallLines.h"
+#include "Gameplay/WallSDF.h"
+#include "Gameplay/WallSoA.h"
 
 namespace gameplay {
 
@@ -11,12 +17,51 @@ namespace gameplay {
     struct Maze {
         std::vector<MazeWall> walls;
 
+        // unique per generated layout, lets consumers cache derived data
+        uint64_t generation = 0;
+
+        // cell layout the walls were generated on (cols == 0 for free-form walls)
+        int   cols = 0, rows = 0;
+        float originX = 0.f, originY = 0.f;
+        float cellW = 0.f, cellH = 0.f;
+        float wallThickness = 0.f;
+
+        // per cell (cols*rows, row-major): bit d set = wall on side d,
+        // N=0 E=1 S=2 W=3; empty for free-form walls
+        std::vector<uint8_t> cellWalls;
+
+        // wall count straight out of the generator, before any merging
+        size_t rawWallCount = 0;
+
+        // cell -> wall lookup used by the collision queries
+        WallGrid grid;
+        // the same walls as bounds arrays, for the vector narrowphase
+        WallSoA soa;
+        // and as unit PGA boundary lines, four per wall
+        WallLines lines;
+
+        // signed distance to the walls, baked by BuildAccel when sdfCellSize > 0
+        float   sdfCellSize = 0.f;
+        WallSDF sdf;
+
+        // BFS distance / flow toward the end cell (MazeGenerator::Options::flowToEnd)
+        FlowField flow;
+
         ThreeBlade startCenter = ThreeBlade(0.f, 0.f, 0.f);
         ThreeBlade endCenter   = ThreeBlade(0.f, 0.f, 0.f);
         float endRadius = 24.f;
 
         bool reachedPrinted = false;
 
+        // rebuilds the lookup structures after 'walls' changed
+        void BuildAccel();
+
+        // Part of cell (cx,cy) no wall can reach (walls straddle cell borders
+        // by half their thickness), shrunk by 'inset'. False without a cell
+        // layout or when nothing is left.
+        bool CellInterior(int cx, int cy, float inset,
+                          float& x0, float& y0, float& x1, float& y1) const;
+
         // PGA-based end check (character circle vs end circle)
         bool IsAtEnd(const ThreeBlade& X, float characterRadius) const {
             TwoBlade L = X & endCenter;
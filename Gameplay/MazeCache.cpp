@@ -0,0 +1,392 @@
+#include "Gameplay/MazeCache.h"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#ifdef _WIN32
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#include "Gameplay/MazeGenerator.h"
+
+namespace gameplay {
+
+namespace {
+
+constexpr char     kMagic[4] = { 'G', 'M', 'Z', 'C' };
+constexpr uint32_t kVersion  = 2;   // file layout
+
+constexpr uint32_t kFlagMerge = 1u << 0;
+constexpr uint32_t kFlagFlow  = 1u << 1;
+
+struct Section {
+    uint64_t offset, count;   // bytes from file start, element count
+};
+
+struct FileHeader {
+    char     magic[4];
+    uint32_t version;
+    uint32_t generator;   // MazeGenerator::kVersion that built it
+
+    // key
+    int32_t  cols, rows;
+    float    margin, wallThickness, width, height;
+    uint32_t seed;
+    uint32_t flags;
+    float    sdfCellSize;
+
+    // maze layout
+    float    originX, originY, cellW, cellH;
+    float    startX, startY, endX, endY, endRadius;
+    uint64_t rawWallCount;
+
+    // wall grid
+    float    gridOriginX, gridOriginY, gridCellW, gridCellH;
+    int32_t  gridCols, gridRows;
+
+    // distance field
+    float    sdfOriginX, sdfOriginY, sdfCell, sdfMaxDist;
+    int32_t  sdfNx, sdfNy;
+
+    Section  bits, walls, cellStart, indices, sdfNodes;
+    uint64_t fileSize;
+};
+
+static_assert(std::is_trivially_copyable_v<FileHeader>);
+static_assert(sizeof(MazeWall) == 4 * sizeof(float), "walls are stored as 4 floats");
+
+// read-only view of a whole file
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile() { Close(); }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool Open(const std::string& path)
+    {
+        Close();
+#ifdef _WIN32
+        m_File = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                             OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (m_File == INVALID_HANDLE_VALUE) return false;
+
+        LARGE_INTEGER size{};
+        if (!GetFileSizeEx(m_File, &size) || size.QuadPart <= 0) { Close(); return false; }
+
+        m_Map = CreateFileMappingA(m_File, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!m_Map) { Close(); return false; }
+
+        m_Data = static_cast<const uint8_t*>(MapViewOfFile(m_Map, FILE_MAP_READ, 0, 0, 0));
+        if (!m_Data) { Close(); return false; }
+        m_Size = size_t(size.QuadPart);
+#else
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+
+        struct stat st{};
+        if (::fstat(fd, &st) != 0 || st.st_size <= 0) { ::close(fd); return false; }
+
+        void* p = ::mmap(nullptr, size_t(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);   // the mapping keeps the file alive
+        if (p == MAP_FAILED) return false;
+
+        m_Data = static_cast<const uint8_t*>(p);
+        m_Size = size_t(st.st_size);
+#endif
+        return true;
+    }
+
+    void Close()
+    {
+#ifdef _WIN32
+        if (m_Data) UnmapViewOfFile(m_Data);
+        if (m_Map) CloseHandle(m_Map);
+        if (m_File != INVALID_HANDLE_VALUE) CloseHandle(m_File);
+        m_Map = nullptr;
+        m_File = INVALID_HANDLE_VALUE;
+#else
+        if (m_Data) ::munmap(const_cast<uint8_t*>(m_Data), m_Size);
+#endif
+        m_Data = nullptr;
+        m_Size = 0;
+    }
+
+    const uint8_t* Data() const { return m_Data; }
+    size_t Size() const { return m_Size; }
+
+private:
+#ifdef _WIN32
+    HANDLE m_File{INVALID_HANDLE_VALUE};
+    HANDLE m_Map{nullptr};
+#endif
+    const uint8_t* m_Data{nullptr};
+    size_t m_Size{0};
+};
+
+// section in bounds for 'count' elements of 'elem' bytes
+bool InFile(const Section& s, size_t elem, size_t fileSize)
+{
+    if (s.offset > fileSize) return false;
+    return s.count <= (fileSize - s.offset) / elem;
+}
+
+MazeKey KeyOf(const FileHeader& h)
+{
+    MazeKey k;
+    k.cols = h.cols;   k.rows = h.rows;
+    k.margin = h.margin;
+    k.wallThickness = h.wallThickness;
+    k.width = h.width; k.height = h.height;
+    k.seed = h.seed;
+    k.mergeWalls  = (h.flags & kFlagMerge) != 0;
+    k.flowToEnd   = (h.flags & kFlagFlow) != 0;
+    k.sdfCellSize = h.sdfCellSize;
+    return k;
+}
+
+} // namespace
+
+uint64_t MazeKey::Hash() const
+{
+    // FNV-1a over the fields (not the struct, it has padding)
+    uint64_t h = 0xCBF29CE484222325ull;
+    auto mix = [&h](const void* p, size_t n) {
+        const auto* b = static_cast<const uint8_t*>(p);
+        for (size_t i = 0; i < n; ++i) { h ^= b[i]; h *= 0x100000001B3ull; }
+    };
+    const uint8_t flags = uint8_t((mergeWalls ? kFlagMerge : 0u) | (flowToEnd ? kFlagFlow : 0u));
+    mix(&cols, sizeof cols);     mix(&rows, sizeof rows);
+    mix(&margin, sizeof margin); mix(&wallThickness, sizeof wallThickness);
+    mix(&width, sizeof width);   mix(&height, sizeof height);
+    mix(&seed, sizeof seed);     mix(&flags, sizeof flags);
+    mix(&sdfCellSize, sizeof sdfCellSize);
+    return h;
+}
+
+MazeCache::MazeCache(std::string dir)
+    : m_Dir{ std::move(dir) }
+{
+}
+
+std::string MazeCache::PathFor(const MazeKey& key) const
+{
+    char name[32];
+    std::snprintf(name, sizeof name, "maze_%016llx.gmz", static_cast<unsigned long long>(key.Hash()));
+    return (std::filesystem::path(m_Dir) / name).string();
+}
+
+bool MazeCache::Load(const MazeKey& key, Maze& out) const
+{
+    if (key.seed == 0) return false;
+
+    MappedFile file;
+    if (!file.Open(PathFor(key))) return false;
+
+    const uint8_t* data = file.Data();
+    const size_t   size = file.Size();
+    if (size < sizeof(FileHeader)) return false;
+
+    FileHeader h;
+    std::memcpy(&h, data, sizeof h);
+    if (std::memcmp(h.magic, kMagic, sizeof kMagic) != 0 || h.version != kVersion) return false;
+    if (h.generator != MazeGenerator::kVersion) return false;   // carved by other code
+    if (h.fileSize != size || !(KeyOf(h) == key)) return false;   // other key hashed here
+    if (h.cols <= 0 || h.rows <= 0) return false;
+
+    const size_t cells = size_t(h.cols) * size_t(h.rows);
+    if (h.bits.count != (cells + 1) / 2 || !InFile(h.bits, 1, size)) return false;
+    if (!InFile(h.walls, sizeof(MazeWall), size)) return false;
+    if (!InFile(h.cellStart, sizeof(uint32_t), size) || !InFile(h.indices, sizeof(uint32_t), size)) return false;
+    if (!InFile(h.sdfNodes, sizeof(float), size)) return false;
+
+    const bool hasGrid = h.cellStart.count != 0;
+    if (hasGrid && (h.gridCols <= 0 || h.gridRows <= 0 ||
+                    h.cellStart.count != size_t(h.gridCols) * size_t(h.gridRows) + 1)) return false;
+
+    // layout
+    out.cols = h.cols;             out.rows = h.rows;
+    out.originX = h.originX;       out.originY = h.originY;
+    out.cellW = h.cellW;           out.cellH = h.cellH;
+    out.wallThickness = h.wallThickness;
+    out.startCenter = ThreeBlade(h.startX, h.startY, 0.f);
+    out.endCenter   = ThreeBlade(h.endX, h.endY, 0.f);
+    out.endRadius   = h.endRadius;
+    out.rawWallCount = size_t(h.rawWallCount);
+    out.sdfCellSize  = h.sdfCellSize;
+    out.reachedPrinted = false;
+
+    // walls
+    out.walls.resize(size_t(h.walls.count));
+    if (!out.walls.empty())
+        std::memcpy(out.walls.data(), data + h.walls.offset, out.walls.size() * sizeof(MazeWall));
+
+    // cell bits, two per byte
+    const uint8_t* bits = data + h.bits.offset;
+    out.cellWalls.resize(cells);
+    for (size_t i = 0; i < cells; ++i)
+        out.cellWalls[i] = uint8_t((bits[i >> 1] >> ((i & 1) * 4)) & 0xF);
+
+    // grid index + distance field; anything missing or broken is rebuilt
+    bool rebuild = !hasGrid;
+    out.grid.Clear();
+    out.sdf.Clear();
+    if (hasGrid) {
+        out.grid.originX = h.gridOriginX; out.grid.originY = h.gridOriginY;
+        out.grid.cellW = h.gridCellW;     out.grid.cellH = h.gridCellH;
+        out.grid.cols = h.gridCols;       out.grid.rows = h.gridRows;
+
+        out.grid.cellStart.resize(size_t(h.cellStart.count));
+        std::memcpy(out.grid.cellStart.data(), data + h.cellStart.offset,
+                    out.grid.cellStart.size() * sizeof(uint32_t));
+        out.grid.indices.resize(size_t(h.indices.count));
+        if (!out.grid.indices.empty())
+            std::memcpy(out.grid.indices.data(), data + h.indices.offset,
+                        out.grid.indices.size() * sizeof(uint32_t));
+
+        // a corrupt index would send the collision queries out of bounds
+        bool ok = out.grid.cellStart.front() == 0 && out.grid.cellStart.back() == out.grid.indices.size();
+        for (size_t i = 1; i < out.grid.cellStart.size(); ++i)
+            ok = ok && out.grid.cellStart[i - 1] <= out.grid.cellStart[i];
+        for (uint32_t w : out.grid.indices) ok = ok && w < out.walls.size();
+        rebuild = !ok;
+    }
+
+    if (!rebuild && h.sdfNodes.count != 0 && h.sdfNodes.offset % alignof(float) == 0) {
+        WallSDF::Layout sl;
+        sl.originX = h.sdfOriginX; sl.originY = h.sdfOriginY;
+        sl.cell = h.sdfCell;       sl.maxDist = h.sdfMaxDist;
+        sl.nx = h.sdfNx;           sl.ny = h.sdfNy;
+        const auto* nodes = reinterpret_cast<const float*>(data + h.sdfNodes.offset);
+        rebuild = !out.sdf.Assign(sl, nodes, size_t(h.sdfNodes.count));
+    } else if (out.sdfCellSize > 0.f) {
+        rebuild = true;
+    }
+    if (rebuild) {
+        out.BuildAccel();
+    } else {
+        out.soa.Build(out.walls);
+        out.lines.Build(out.walls);
+    }
+
+    // the flow field is a cheap BFS over the bits, not worth storing
+    out.flow.Clear();
+    if (key.flowToEnd && out.flow.Reset(out)) {
+        int ex, ey;
+        if (out.flow.CellAt(h.endX, h.endY, ex, ey)) out.flow.Build(ex, ey);
+    }
+
+    out.generation = MazeGenerator::NextGeneration();
+    return true;
+}
+
+bool MazeCache::Store(const MazeKey& key, const Maze& maze) const
+{
+    if (key.seed == 0 || maze.cols <= 0 || maze.rows <= 0) return false;
+
+    const size_t cells = size_t(maze.cols) * size_t(maze.rows);
+    if (maze.cellWalls.size() != cells) return false;
+
+    FileHeader h{};
+    std::memcpy(h.magic, kMagic, sizeof kMagic);
+    h.version = kVersion;
+    h.generator = MazeGenerator::kVersion;
+
+    h.cols = key.cols;   h.rows = key.rows;
+    h.margin = key.margin;
+    h.wallThickness = key.wallThickness;
+    h.width = key.width; h.height = key.height;
+    h.seed = key.seed;
+    h.flags = (key.mergeWalls ? kFlagMerge : 0u) | (key.flowToEnd ? kFlagFlow : 0u);
+    h.sdfCellSize = key.sdfCellSize;
+
+    h.originX = maze.originX; h.originY = maze.originY;
+    h.cellW = maze.cellW;     h.cellH = maze.cellH;
+    h.startX = maze.startCenter[0]; h.startY = maze.startCenter[1];
+    h.endX = maze.endCenter[0];     h.endY = maze.endCenter[1];
+    h.endRadius = maze.endRadius;
+    h.rawWallCount = maze.rawWallCount;
+
+    h.gridOriginX = maze.grid.originX; h.gridOriginY = maze.grid.originY;
+    h.gridCellW = maze.grid.cellW;     h.gridCellH = maze.grid.cellH;
+    h.gridCols = maze.grid.cols;       h.gridRows = maze.grid.rows;
+
+    const WallSDF::Layout sl = maze.sdf.GetLayout();
+    h.sdfOriginX = sl.originX; h.sdfOriginY = sl.originY;
+    h.sdfCell = sl.cell;       h.sdfMaxDist = sl.maxDist;
+    h.sdfNx = sl.nx;           h.sdfNy = sl.ny;
+
+    std::vector<uint8_t> buf(sizeof(FileHeader), 0);
+    auto append = [&buf](const void* src, size_t elem, size_t count) {
+        buf.resize((buf.size() + 7) & ~size_t(7), 0);
+        Section s{ buf.size(), count };
+        const auto* b = static_cast<const uint8_t*>(src);
+        if (count) buf.insert(buf.end(), b, b + elem * count);
+        return s;
+    };
+
+    std::vector<uint8_t> bits((cells + 1) / 2, 0);
+    for (size_t i = 0; i < cells; ++i)
+        bits[i >> 1] |= uint8_t((maze.cellWalls[i] & 0xF) << ((i & 1) * 4));
+
+    h.bits      = append(bits.data(), 1, bits.size());
+    h.walls     = append(maze.walls.data(), sizeof(MazeWall), maze.walls.size());
+    h.cellStart = append(maze.grid.cellStart.data(), sizeof(uint32_t), maze.grid.cellStart.size());
+    h.indices   = append(maze.grid.indices.data(), sizeof(uint32_t), maze.grid.indices.size());
+    h.sdfNodes  = append(maze.sdf.Nodes().data(), sizeof(float), maze.sdf.Nodes().size());
+    h.fileSize  = buf.size();
+    std::memcpy(buf.data(), &h, sizeof h);
+
+    // write aside and rename, so readers never map a half-written file
+    std::error_code ec;
+    std::filesystem::create_directories(m_Dir, ec);
+
+    const std::string path = PathFor(key);
+    const std::string tmp  = path + ".tmp" + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+    {
+        std::ofstream f(tmp, std::ios::binary | std::ios::trunc);
+        if (!f) return false;
+        f.write(reinterpret_cast<const char*>(buf.data()), std::streamsize(buf.size()));
+        if (!f) { f.close(); std::filesystem::remove(tmp, ec); return false; }
+    }
+    std::filesystem::rename(tmp, path, ec);
+    if (ec) { std::filesystem::remove(tmp, ec); return false; }
+    return true;
+}
+
+bool MazeCache::LoadOrGenerate(const MazeKey& key, Maze& out)
+{
+    if (Load(key, out)) {
+        m_Hits.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    m_Misses.fetch_add(1, std::memory_order_relaxed);
+
+    MazeGenerator::Options opts;
+    opts.mergeWalls  = key.mergeWalls;
+    opts.flowToEnd   = key.flowToEnd;
+    opts.sdfCellSize = key.sdfCellSize;
+    MazeGenerator::Generate(out, key.cols, key.rows, key.margin, key.wallThickness,
+                            key.width, key.height, key.seed, opts);
+    Store(key, out);
+    return false;
+}
+
+} // namespace gameplay
@@ -0,0 +1,67 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "Gameplay/Maze.h"
+
+namespace gameplay {
+
+    // Everything MazeGenerator::Generate needs to reproduce a layout, plus the
+    // options that change the stored data.
+    struct MazeKey {
+        int32_t  cols = 0, rows = 0;
+        float    margin = 0.f, wallThickness = 0.f;
+        float    width = 0.f, height = 0.f;
+        uint32_t seed = 0;   // 0 = random_device, never cached
+
+        bool  mergeWalls = false;
+        bool  flowToEnd = false;
+        float sdfCellSize = 0.f;
+
+        uint64_t Hash() const;
+        bool operator==(const MazeKey&) const = default;
+    };
+
+    // Seed-addressable store of generated mazes, one file per key under 'dir'.
+    //
+    // File layout (native endian, every array 8-byte aligned):
+    //   header   magic "GMZC", file and generator versions, the full key,
+    //            maze layout, wall grid and SDF parameters, then
+    //            (offset, count) for each array
+    //   bits     cellWalls packed as nibbles, two cells per byte
+    //   walls    final (merged) rectangles, 4 floats each
+    //   grid     WallGrid cellStart + indices
+    //   sdf      WallSDF nodes (d, gx, gy)
+    //
+    // Loading maps the file and copies the arrays straight into the Maze, so
+    // no carving, merging or SDF baking runs; only the flow field, a BFS
+    // over the cell bits, is rebuilt. Load/Store are safe from several
+    // threads; stores go through a temp file and a rename.
+    class MazeCache {
+    public:
+        explicit MazeCache(std::string dir = "mazecache");
+
+        MazeCache(const MazeCache&) = delete;
+        MazeCache& operator=(const MazeCache&) = delete;
+
+        const std::string& Dir() const { return m_Dir; }
+        std::string PathFor(const MazeKey& key) const;
+
+        // false when missing, stale (other file/generator version or key) or malformed
+        bool Load(const MazeKey& key, Maze& out) const;
+        bool Store(const MazeKey& key, const Maze& maze) const;
+
+        // loads the maze, or generates and stores it on a miss; true on a hit
+        bool LoadOrGenerate(const MazeKey& key, Maze& out);
+
+        size_t Hits() const   { return m_Hits.load(std::memory_order_relaxed); }
+        size_t Misses() const { return m_Misses.load(std::memory_order_relaxed); }
+
+    private:
+        std::string m_Dir;
+        std::atomic<size_t> m_Hits{0}, m_Misses{0};
+    };
+
+} // namespace gameplay
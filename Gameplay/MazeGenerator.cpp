@@ -1,10 +1,14 @@
-#include "gameplay/MazeGenerator.h"
+#include "Gameplay/MazeGenerator.h"
+#include <atomic>
 #include <vector>
 #include <stack>
 #include <random>
 #include <algorithm>
 #include <cmath>
 
+#include "Gameplay/PackedMaze.h"
+#include "Gameplay/SeedMix.h"
+
 namespace gameplay {
 
 struct Cell {
@@ -15,12 +19,45 @@ struct Cell {
 
 static inline int idx(int x, int y, int cols) { return y * cols + x; }
 
+static std::atomic<uint64_t> s_NextGeneration{1};
+
+uint64_t MazeGenerator::NextGeneration()
+{
+    return s_NextGeneration.fetch_add(1, std::memory_order_relaxed);
+}
+
+// per-cell wall bits for path queries (bit d = wall on side d)
+template <class HasWall>
+static void FillCellWalls(Maze& out, int cols, int rows, HasWall&& hasWall)
+{
+    out.cellWalls.assign(size_t(cols) * size_t(rows), 0);
+    for (int y = 0; y < rows; ++y) {
+        for (int x = 0; x < cols; ++x) {
+            uint8_t bits = 0;
+            for (int d = 0; d < 4; ++d)
+                if (hasWall(x, y, d)) bits |= uint8_t(1u << d);
+            out.cellWalls[size_t(y) * size_t(cols) + size_t(x)] = bits;
+        }
+    }
+}
+
 void MazeGenerator::Generate(Maze& out,
                              int cols, int rows,
                              float margin,
                              float wallThickness,
                              float width, float height,
                              uint32_t seed)
+{
+    Generate(out, cols, rows, margin, wallThickness, width, height, seed, Options{});
+}
+
+void MazeGenerator::Generate(Maze& out,
+                             int cols, int rows,
+                             float margin,
+                             float wallThickness,
+                             float width, float height,
+                             uint32_t seed,
+                             const Options& opts)
 {
     cols = std::max(2, cols);
     rows = std::max(2, rows);
@@ -40,56 +77,74 @@ void MazeGenerator::Generate(Maze& out,
     float cellW  = innerW / cols;
     float cellH  = innerH / rows;
 
-    std::vector<Cell> grid(cols * rows);
-    std::stack<std::pair<int,int>> st;
-
-    auto neighbors = [&](int x, int y) {
-        struct N { int nx, ny, dir; };
-        std::vector<N> nv;
-        if (y + 1 < rows) nv.push_back({ x,     y + 1, 0 }); // N
-        if (x + 1 < cols) nv.push_back({ x + 1, y,     1 }); // E
-        if (y - 1 >= 0)   nv.push_back({ x,     y - 1, 2 }); // S
-        if (x - 1 >= 0)   nv.push_back({ x - 1, y,     3 }); // W
-        std::shuffle(nv.begin(), nv.end(), rng);
-        return nv;
-    };
+    std::vector<Cell> grid;
+    thread_local PackedMaze packed;
+    int endX = 0, endY = 0;
+
+    if (opts.packed) {
+        const uint32_t packedSeed = seed != 0 ? seed : uint32_t(rng()) | 1u;
+        if (opts.regionSize > 0)
+            packed.GenerateParallel(cols, rows, packedSeed, opts.regionSize, opts.jobs);
+        else
+            packed.Generate(cols, rows, packedSeed);
+        endX = packed.EndX();
+        endY = packed.EndY();
+    } else {
+        grid.resize(cols * rows);
+        std::stack<std::pair<int,int>> st;
 
-    // DFS backtracker from start (0,0)
-    grid[idx(0,0,cols)].visited = true;
-    st.push({0,0});
-
-    while (!st.empty()) {
-        auto [x, y] = st.top();
-        auto nv = neighbors(x, y);
-        bool moved = false;
-        for (auto n : nv) {
-            if (!grid[idx(n.nx, n.ny, cols)].visited) {
-                int d  = n.dir;
-                int od = (d + 2) % 4;
-                grid[idx(x, y, cols)].w[d] = false;
-                grid[idx(n.nx, n.ny, cols)].w[od] = false;
-                grid[idx(n.nx, n.ny, cols)].visited = true;
-                st.push({ n.nx, n.ny });
-                moved = true;
-                break;
+        auto neighbors = [&](int x, int y) {
+            struct N { int nx, ny, dir; };
+            std::vector<N> nv;
+            if (y + 1 < rows) nv.push_back({ x,     y + 1, 0 }); // N
+            if (x + 1 < cols) nv.push_back({ x + 1, y,     1 }); // E
+            if (y - 1 >= 0)   nv.push_back({ x,     y - 1, 2 }); // S
+            if (x - 1 >= 0)   nv.push_back({ x - 1, y,     3 }); // W
+            std::shuffle(nv.begin(), nv.end(), rng);
+            return nv;
+        };
+
+        // DFS backtracker from start (0,0)
+        grid[idx(0,0,cols)].visited = true;
+        st.push({0,0});
+
+        while (!st.empty()) {
+            auto [x, y] = st.top();
+            auto nv = neighbors(x, y);
+            bool moved = false;
+            for (auto n : nv) {
+                if (!grid[idx(n.nx, n.ny, cols)].visited) {
+                    int d  = n.dir;
+                    int od = (d + 2) % 4;
+                    grid[idx(x, y, cols)].w[d] = false;
+                    grid[idx(n.nx, n.ny, cols)].w[od] = false;
+                    grid[idx(n.nx, n.ny, cols)].visited = true;
+                    st.push({ n.nx, n.ny });
+                    moved = true;
+                    break;
+                }
             }
+            if (!moved) st.pop();
         }
-        if (!moved) st.pop();
-    }
 
-    // Choose random end cell != (0,0)
-    int endX = 0, endY = 0;
-    {
-        std::uniform_int_distribution<int> distX(0, cols - 1);
-        std::uniform_int_distribution<int> distY(0, rows - 1);
-        do {
-            endX = distX(rng);
-            endY = distY(rng);
-        } while (endX == 0 && endY == 0);
+        // Choose random end cell != (0,0)
+        {
+            std::uniform_int_distribution<int> distX(0, cols - 1);
+            std::uniform_int_distribution<int> distY(0, rows - 1);
+            do {
+                endX = distX(rng);
+                endY = distY(rng);
+            } while (endX == 0 && endY == 0);
+        }
+
+        // Open the start to the outside on the bottom edge by removing SOUTH wall
+        grid[idx(0, 0, cols)].w[2] = false;
     }
 
-    // Open the start to the outside on the bottom edge by removing SOUTH wall
-    grid[idx(0, 0, cols)].w[2] = false;
+    // PackedMaze keeps the start opening implicit
+    auto hasWall = [&](int x, int y, int d) {
+        return opts.packed ? packed.HasWall(x, y, d) : grid[idx(x, y, cols)].w[d];
+    };
 
     // Convert to rectangles
     out.walls.clear();
@@ -106,18 +161,17 @@ void MazeGenerator::Generate(Maze& out,
     // and then emit South walls for the bottom row and West walls for the left column.
     for (int y = 0; y < rows; ++y) {
         for (int x = 0; x < cols; ++x) {
-            const Cell& c = grid[idx(x, y, cols)];
             float cx = left   + x * cellW;
             float cy = bottom + y * cellH;
 
             // North wall of this cell
-            if (c.w[0]) {
+            if (hasWall(x, y, 0)) {
                 float wx = cx;
                 float wy = cy + cellH - wallThickness * 0.5f;
                 addRect(wx, wy, cellW, wallThickness);
             }
             // East wall of this cell
-            if (c.w[1]) {
+            if (hasWall(x, y, 1)) {
                 float wx = cx + cellW - wallThickness * 0.5f;
                 float wy = cy;
                 addRect(wx, wy, wallThickness, cellH);
@@ -127,8 +181,7 @@ void MazeGenerator::Generate(Maze& out,
 
     // Bottom row South walls (y=0)
     for (int x = 0; x < cols; ++x) {
-        const Cell& c = grid[idx(x, 0, cols)];
-        if (c.w[2]) {
+        if (hasWall(x, 0, 2)) {
             float wx = left + x * cellW;
             float wy = bottom - wallThickness * 0.5f;
             addRect(wx, wy, cellW, wallThickness);
@@ -136,8 +189,7 @@ void MazeGenerator::Generate(Maze& out,
     }
     // Left column West walls (x=0)
     for (int y = 0; y < rows; ++y) {
-        const Cell& c = grid[idx(0, y, cols)];
-        if (c.w[3]) {
+        if (hasWall(0, y, 3)) {
             float wx = left - wallThickness * 0.5f;
             float wy = bottom + y * cellH;
             addRect(wx, wy, wallThickness, cellH);
@@ -154,6 +206,343 @@ void MazeGenerator::Generate(Maze& out,
     out.endCenter   = ThreeBlade(endCx,   endCy,   0.f);
     out.endRadius   = 0.30f * std::min(cellW, cellH);
     out.reachedPrinted = false;
+    out.generation = s_NextGeneration.fetch_add(1, std::memory_order_relaxed);
+
+    out.cols = cols;
+    out.rows = rows;
+    out.originX = left;
+    out.originY = bottom;
+    out.cellW = cellW;
+    out.cellH = cellH;
+    out.wallThickness = wallThickness;
+
+    FillCellWalls(out, cols, rows, hasWall);
+    if (opts.flowToEnd) {
+        out.flow.Reset(out);
+        out.flow.Build(endX, endY);
+    } else {
+        out.flow.Clear();
+    }
+
+    out.rawWallCount = out.walls.size();
+    if (opts.mergeWalls) MergeWalls(out.walls);
+
+    out.sdfCellSize = opts.sdfCellSize;
+    out.BuildAccel();
+}
+
+// --- streaming bands (Eller's algorithm) ---
+
+// per-row / per-seam RNG seeds, independent of generation order
+static inline uint32_t RowSeed(uint32_t seed, int64_t row, uint64_t salt)
+{
+    return uint32_t(SplitMix64(SplitMix64(uint64_t(seed) ^ salt) + uint64_t(row)));
+}
+
+static constexpr uint64_t kRowSalt  = 0x726F77ull;    // "row"
+static constexpr uint64_t kSeamSalt = 0x7365616Dull;  // "seam"
+static constexpr uint64_t kTileSalt = 0x74696C65ull;  // "tile"
+
+// column of the single passage from band's top row into band+1
+static inline int SeamColumn(const MazeGenerator::BandParams& p, int64_t band)
+{
+    return int(RowSeed(p.seed, band, kSeamSalt) % uint32_t(p.cols));
+}
+
+void MazeGenerator::GenerateBand(Maze& out, const BandParams& p, int64_t band)
+{
+    const int cols = std::max(2, p.cols);
+    const int rows = std::max(1, p.bandRows);
+    const float t  = p.wallThickness;
+    const int64_t row0 = band * rows;
+
+    const float left   = p.originX;
+    const float bottom = p.originY + float(row0) * p.cellH;
+
+    out.walls.clear();
+    out.walls.reserve(size_t(cols) * size_t(rows) * 2 + size_t(rows));
+
+    // Eller state for the current row: set label per cell (labels stay in
+    // [0, cols) because a row never holds more than cols sets)
+    thread_local std::vector<int>     set, members;
+    thread_local std::vector<uint8_t> used, east, down, hasDown, prevDown;
+    set.assign(cols, -1);
+    used.assign(cols, 0);
+    east.assign(cols, 1);
+    down.assign(cols, 0);
+    hasDown.assign(cols, 0);
+
+    const int seamCol = SeamColumn(p, band);
+
+    // the passage up from band-1 is this band's first-row south opening
+    prevDown.assign(cols, 0);
+    prevDown[SeamColumn(p, band - 1)] = 1;
+    out.cellWalls.assign(size_t(cols) * size_t(rows), 0);
+
+    for (int r = 0; r < rows; ++r) {
+        const bool last = (r == rows - 1);
+        std::mt19937 rng(RowSeed(p.seed, row0 + r, kRowSalt));
+        std::bernoulli_distribution coin(0.5);
+
+        // fresh labels for cells that did not come down from the row below
+        std::fill(used.begin(), used.end(), 0);
+        for (int c = 0; c < cols; ++c) if (set[c] >= 0) used[set[c]] = 1;
+        int nextFree = 0;
+        for (int c = 0; c < cols; ++c) {
+            if (set[c] >= 0) continue;
+            while (used[nextFree]) ++nextFree;
+            set[c] = nextFree;
+            used[nextFree] = 1;
+        }
+
+        // join neighbours in different sets (always on the last row)
+        for (int c = 0; c + 1 < cols; ++c) {
+            east[c] = 1;
+            if (set[c] == set[c + 1] || !(last || coin(rng))) continue;
+            east[c] = 0;
+            const int from = set[c + 1], to = set[c];
+            for (int k = 0; k < cols; ++k) if (set[k] == from) set[k] = to;
+        }
+        east[cols - 1] = 1;
+
+        // carve north: random cells, then at least one per set
+        std::fill(down.begin(), down.end(), 0);
+        if (!last) {
+            std::fill(hasDown.begin(), hasDown.end(), 0);
+            for (int c = 0; c < cols; ++c) {
+                if (coin(rng)) { down[c] = 1; hasDown[set[c]] = 1; }
+            }
+            for (int s = 0; s < cols; ++s) {
+                if (hasDown[s]) continue;
+                members.clear();
+                for (int c = 0; c < cols; ++c) if (set[c] == s) members.push_back(c);
+                if (members.empty()) continue;
+                std::uniform_int_distribution<int> pick(0, int(members.size()) - 1);
+                down[members[pick(rng)]] = 1;
+                hasDown[s] = 1;
+            }
+        } else {
+            down[seamCol] = 1;   // the only way into the next band
+        }
+
+        // emit this row (same rectangle layout as Generate)
+        const float cy = bottom + r * p.cellH;
+        out.walls.push_back({ left - t * 0.5f, cy, t, p.cellH });   // west border
+        for (int c = 0; c < cols; ++c) {
+            const float cx = left + c * p.cellW;
+            if (!down[c]) out.walls.push_back({ cx, cy + p.cellH - t * 0.5f, p.cellW, t });
+            if (east[c])  out.walls.push_back({ cx + p.cellW - t * 0.5f, cy, t, p.cellH });
+        }
+
+        for (int c = 0; c < cols; ++c) {
+            uint8_t bits = 0;
+            if (!down[c])                    bits |= 1u;   // N
+            if (east[c])                     bits |= 2u;   // E
+            if (!prevDown[c])                bits |= 4u;   // S
+            if (c == 0 || east[c - 1])       bits |= 8u;   // W
+            out.cellWalls[size_t(r) * size_t(cols) + size_t(c)] = bits;
+        }
+        prevDown = down;
+
+        // cells carried up keep their set, the rest start fresh
+        for (int c = 0; c < cols; ++c) if (!down[c]) set[c] = -1;
+    }
+
+    out.startCenter = ThreeBlade(left + 0.5f * p.cellW, bottom + 0.5f * p.cellH, 0.f);
+    out.endCenter   = ThreeBlade(left + (seamCol + 0.5f) * p.cellW,
+                                 bottom + (rows - 0.5f) * p.cellH, 0.f);
+    out.endRadius   = 0.30f * std::min(p.cellW, p.cellH);
+    out.reachedPrinted = false;
+    out.generation = s_NextGeneration.fetch_add(1, std::memory_order_relaxed);
+
+    out.cols = cols;
+    out.rows = rows;
+    out.originX = left;
+    out.originY = bottom;
+    out.cellW = p.cellW;
+    out.cellH = p.cellH;
+    out.wallThickness = t;
+    out.rawWallCount = out.walls.size();
+    out.flow.Clear();
+
+    out.BuildAccel();
+}
+
+// --- 2D tiles ---
+
+void MazeGenerator::GenerateTile(Maze& out, const TileParams& p, int32_t tx, int32_t ty)
+{
+    const int cols = std::max(2, p.cols);
+    const int rows = std::max(2, p.rows);
+    const float t  = p.wallThickness;
+
+    const uint64_t key = (uint64_t(uint32_t(tx)) << 32) | uint32_t(ty);
+    std::mt19937 rng(RowSeed(p.seed, int64_t(key), kTileSalt));
+
+    thread_local PackedMaze packed;
+    packed.Generate(cols, rows, uint32_t(rng()) | 1u);
+
+    const int northDoor = int(rng() % uint32_t(cols));
+    const int eastDoor  = int(rng() % uint32_t(rows));
+
+    // outer edges count as walls except the two doors this tile owns
+    FillCellWalls(out, cols, rows, [&](int x, int y, int d) {
+        switch (d) {
+            case PackedMaze::N: return packed.HasWall(x, y, d) && !(y == rows - 1 && x == northDoor);
+            case PackedMaze::E: return packed.HasWall(x, y, d) && !(x == cols - 1 && y == eastDoor);
+            case PackedMaze::S: return y == 0 || packed.HasWall(x, y, d);
+            default:            return x == 0 || packed.HasWall(x, y, d);
+        }
+    });
+
+    const float left   = float(tx) * cols * p.cellW;
+    const float bottom = float(ty) * rows * p.cellH;
+
+    out.walls.clear();
+    out.walls.reserve(size_t(cols) * size_t(rows) + size_t(cols + rows));
+
+    for (int y = 0; y < rows; ++y) {
+        for (int x = 0; x < cols; ++x) {
+            const float cx = left   + x * p.cellW;
+            const float cy = bottom + y * p.cellH;
+
+            const bool north = packed.HasWall(x, y, PackedMaze::N) && !(y == rows - 1 && x == northDoor);
+            const bool east  = packed.HasWall(x, y, PackedMaze::E) && !(x == cols - 1 && y == eastDoor);
+            if (north) out.walls.push_back({ cx, cy + p.cellH - t * 0.5f, p.cellW, t });
+            if (east)  out.walls.push_back({ cx + p.cellW - t * 0.5f, cy, t, p.cellH });
+        }
+    }
+
+    out.startCenter = ThreeBlade(left + 0.5f * p.cellW, bottom + 0.5f * p.cellH, 0.f);
+    out.endCenter   = out.startCenter;
+    out.endRadius   = 0.f;
+    out.reachedPrinted = false;
+    out.generation = s_NextGeneration.fetch_add(1, std::memory_order_relaxed);
+
+    out.cols = cols;
+    out.rows = rows;
+    out.originX = left;
+    out.originY = bottom;
+    out.cellW = p.cellW;
+    out.cellH = p.cellH;
+    out.wallThickness = t;
+    out.rawWallCount = out.walls.size();
+    out.flow.Clear();
+
+    out.BuildAccel();
+}
+
+// --- wall merging ---
+
+static constexpr float kMergeEps = 1e-3f;
+
+static inline bool IsHorizontal(const MazeWall& w) { return w.w >= w.h; }
+
+// Joins touching pieces along one axis. 'along' picks the running axis:
+// true -> runs along x (horizontal walls), false -> along y.
+static void MergeRuns(std::vector<MazeWall>& ws, bool along)
+{
+    auto lineOf = [&](const MazeWall& w) { return along ? w.y : w.x; };
+    auto spanOf = [&](const MazeWall& w) { return along ? w.h : w.w; };
+    auto startOf = [&](const MazeWall& w) { return along ? w.x : w.y; };
+    auto lenOf   = [&](const MazeWall& w) { return along ? w.w : w.h; };
+
+    std::sort(ws.begin(), ws.end(), [&](const MazeWall& a, const MazeWall& b) {
+        if (std::fabs(lineOf(a) - lineOf(b)) > kMergeEps) return lineOf(a) < lineOf(b);
+        if (std::fabs(spanOf(a) - spanOf(b)) > kMergeEps) return spanOf(a) < spanOf(b);
+        return startOf(a) < startOf(b);
+    });
+
+    std::vector<MazeWall> out;
+    out.reserve(ws.size());
+    for (const MazeWall& w : ws) {
+        if (!out.empty()) {
+            MazeWall& cur = out.back();
+            const bool sameLine = std::fabs(lineOf(cur) - lineOf(w)) <= kMergeEps &&
+                                  std::fabs(spanOf(cur) - spanOf(w)) <= kMergeEps;
+            const float curEnd = startOf(cur) + lenOf(cur);
+            if (sameLine && startOf(w) <= curEnd + kMergeEps) {
+                const float end = std::max(curEnd, startOf(w) + lenOf(w));
+                if (along) cur.w = end - cur.x; else cur.h = end - cur.y;
+                continue;
+            }
+        }
+        out.push_back(w);
+    }
+    ws.swap(out);
+}
+
+// Trims the ends of 'ws' that are fully covered (across their whole width)
+// by a single wall of 'covers'. along == true trims x-ends of horizontal walls.
+static void TrimEnds(std::vector<MazeWall>& ws, const std::vector<MazeWall>& covers, bool along)
+{
+    if (covers.empty()) return;
+
+    WallGrid g;
+    float cell = 0.f;
+    for (const auto& c : covers) cell = std::max(cell, std::min(c.w, c.h));
+    g.BuildUniform(covers, std::max(1.f, 4.f * cell));
+
+    std::vector<uint32_t> near;
+    std::vector<MazeWall> out;
+    out.reserve(ws.size());
+
+    for (MazeWall w : ws) {
+        // work in (s = running axis, t = across axis)
+        float s0 = along ? w.x : w.y;
+        float s1 = s0 + (along ? w.w : w.h);
+        const float t0 = along ? w.y : w.x;
+        const float t1 = t0 + (along ? w.h : w.w);
+
+        auto coversAt = [&](float s, float& c0, float& c1) {
+            const float qx = along ? s : t0, qy = along ? t0 : s;
+            g.Query(qx - kMergeEps, qy - kMergeEps,
+                    qx + (along ? kMergeEps : t1 - t0) + kMergeEps,
+                    qy + (along ? t1 - t0 : kMergeEps) + kMergeEps, near);
+            for (uint32_t i : near) {
+                const MazeWall& c = covers[i];
+                const float cs0 = along ? c.x : c.y, cs1 = cs0 + (along ? c.w : c.h);
+                const float ct0 = along ? c.y : c.x, ct1 = ct0 + (along ? c.h : c.w);
+                if (ct0 <= t0 + kMergeEps && ct1 >= t1 - kMergeEps &&
+                    cs0 <= s + kMergeEps && cs1 >= s - kMergeEps) {
+                    c0 = cs0; c1 = cs1;
+                    return true;
+                }
+            }
+            return false;
+        };
+
+        float c0, c1;
+        if (coversAt(s1, c0, c1) && c0 > s0 + kMergeEps) s1 = std::min(s1, c0);
+        if (coversAt(s0, c0, c1) && c1 < s1 - kMergeEps) s0 = std::max(s0, c1);
+
+        if (s1 - s0 <= kMergeEps) continue;   // fully inside crossing walls
+        if (along) { w.x = s0; w.w = s1 - s0; } else { w.y = s0; w.h = s1 - s0; }
+        out.push_back(w);
+    }
+    ws.swap(out);
+}
+
+size_t MazeGenerator::MergeWalls(std::vector<MazeWall>& walls)
+{
+    const size_t before = walls.size();
+
+    std::vector<MazeWall> hor, ver;
+    for (const auto& w : walls) (IsHorizontal(w) ? hor : ver).push_back(w);
+
+    MergeRuns(hor, true);
+    MergeRuns(ver, false);
+
+    // vertical ends inside a horizontal first, then horizontal ends inside
+    // what is left of the verticals, so every removed piece stays covered
+    TrimEnds(ver, hor, false);
+    TrimEnds(hor, ver, true);
+
+    walls.clear();
+    walls.reserve(hor.size() + ver.size());
+    walls.insert(walls.end(), hor.begin(), hor.end());
+    walls.insert(walls.end(), ver.begin(), ver.end());
+    return before;
 }
 
 } // namespace gameplay
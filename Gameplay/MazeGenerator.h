@@ -4,14 +4,86 @@
 
 namespace gameplay {
 
+    class JobSystem;
+
     struct MazeGenerator {
 
+        // bump whenever a seed would carve or bake something different;
+        // MazeCache drops files written by another version
+        static constexpr uint32_t kVersion = 1;
+
+        struct Options {
+            // join contiguous collinear wall pieces into maximal spans
+            bool mergeWalls = false;
+            // bake Maze::flow: BFS distances / directions toward the end cell
+            bool flowToEnd = false;
+            // > 0 bakes Maze::sdf with this node spacing
+            float sdfCellSize = 0.f;
+            // carve on the bit-packed PackedMaze instead of the Cell grid
+            bool packed = false;
+            // packed only: > 0 carves regions of this many cells square in
+            // parallel on 'jobs' and stitches them (PackedMaze::GenerateParallel)
+            int        regionSize = 0;
+            JobSystem* jobs = nullptr;
+        };
+
         static void Generate(Maze& out,
                              int cols, int rows,
                              float margin,
                              float wallThickness,
                              float width, float height,
                              uint32_t seed = 0);
+
+        static void Generate(Maze& out,
+                             int cols, int rows,
+                             float margin,
+                             float wallThickness,
+                             float width, float height,
+                             uint32_t seed,
+                             const Options& opts);
+
+        // Layout of an unbounded maze that grows in +y, one band of rows at a time.
+        struct BandParams {
+            int   cols = 14;
+            int   bandRows = 8;
+            float originX = 0.f, originY = 0.f;   // bottom-left of row 0
+            float cellW = 64.f, cellH = 64.f;
+            float wallThickness = 20.f;
+            uint32_t seed = 1;
+        };
+
+        // Eller's algorithm over rows [band*bandRows, (band+1)*bandRows):
+        // walls are emitted one row at a time with O(cols) state, and every
+        // row draws from its own seeded RNG, so any band can be regenerated
+        // on its own. Each band is a perfect maze; its top row is closed
+        // except for one seeded passage into band+1, so the bands together
+        // form one perfect maze. A band owns its north and east walls (plus
+        // the west border); its south edge belongs to band-1.
+        static void GenerateBand(Maze& out, const BandParams& p, int64_t band);
+
+        // One tile of an endless 2D maze, placed at
+        // (tx * cols * cellW, ty * rows * cellH).
+        struct TileParams {
+            int   cols = 8, rows = 8;
+            float cellW = 80.f, cellH = 80.f;
+            float wallThickness = 16.f;
+            uint32_t seed = 1;
+        };
+
+        // Perfect maze inside the tile (carved on PackedMaze). The tile owns
+        // its north and east edges, each closed except for one seeded door,
+        // so neighbouring tiles always connect; south/west edges belong to
+        // the tiles below / to the left.
+        static void GenerateTile(Maze& out, const TileParams& p, int32_t tx, int32_t ty);
+
+        // fresh Maze::generation for layouts that didn't come out of Generate*
+        // (e.g. loaded from a MazeCache)
+        static uint64_t NextGeneration();
+
+        // Merges adjacent collinear rectangles and trims the ends that lie
+        // fully inside a crossing wall, without changing the covered area.
+        // Returns the wall count before merging.
+        static size_t MergeWalls(std::vector<MazeWall>& walls);
     };
 
 } // namespace gameplay
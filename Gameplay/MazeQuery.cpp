@@ -0,0 +1,315 @@
+#include "Gameplay/MazeQuery.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "Gameplay/JobSystem.h"
+
+namespace gameplay {
+
+// entry time in [0,1] of p0 + t*d into the box, with the entered side's normal
+static inline bool RayBox(float px, float py, float dx, float dy,
+                          float x0, float y0, float x1, float y1,
+                          float& t, float& nx, float& ny)
+{
+    float tEnter = 0.f, tExit = 1.f;
+    float enx = 0.f, eny = 0.f;
+
+    if (std::fabs(dx) < 1e-12f) {
+        if (px < x0 || px > x1) return false;
+    } else {
+        const float inv = 1.f / dx;
+        float ta = (x0 - px) * inv, tb = (x1 - px) * inv;
+        const float n = dx > 0.f ? -1.f : 1.f;
+        if (ta > tb) std::swap(ta, tb);
+        if (ta > tEnter) { tEnter = ta; enx = n; eny = 0.f; }
+        tExit = std::min(tExit, tb);
+    }
+    if (std::fabs(dy) < 1e-12f) {
+        if (py < y0 || py > y1) return false;
+    } else {
+        const float inv = 1.f / dy;
+        float ta = (y0 - py) * inv, tb = (y1 - py) * inv;
+        const float n = dy > 0.f ? -1.f : 1.f;
+        if (ta > tb) std::swap(ta, tb);
+        if (ta > tEnter) { tEnter = ta; enx = 0.f; eny = n; }
+        tExit = std::min(tExit, tb);
+    }
+
+    if (tEnter > tExit || (enx == 0.f && eny == 0.f)) return false;
+    t = tEnter; nx = enx; ny = eny;
+    return true;
+}
+
+// entry time in [0,1] of p0 + t*d into the circle (c, r), p0 outside it
+static inline bool RayCircle(float px, float py, float dx, float dy,
+                             float cx, float cy, float r, float& t)
+{
+    const float ox = px - cx, oy = py - cy;
+    const float a = dx*dx + dy*dy;
+    const float b = ox*dx + oy*dy;
+    const float c = ox*ox + oy*oy - r*r;
+    if (a < 1e-12f || b >= 0.f) return false;   // not moving toward it
+    const float disc = b*b - a*c;
+    if (disc < 0.f) return false;
+    const float tt = (-b - std::sqrt(disc)) / a;
+    if (tt < 0.f || tt > 1.f) return false;
+    t = tt;
+    return true;
+}
+
+// [tIn, tOut] of p0 + t*d, t in [0,1], inside the box
+static bool ClipSegment(float px, float py, float dx, float dy,
+                        float x0, float y0, float x1, float y1,
+                        float& tIn, float& tOut)
+{
+    tIn = 0.f; tOut = 1.f;
+    const float p[2] = { px, py }, d[2] = { dx, dy };
+    const float lo[2] = { x0, y0 }, hi[2] = { x1, y1 };
+    for (int a = 0; a < 2; ++a) {
+        if (std::fabs(d[a]) < 1e-12f) {
+            if (p[a] < lo[a] || p[a] > hi[a]) return false;
+            continue;
+        }
+        float ta = (lo[a] - p[a]) / d[a], tb = (hi[a] - p[a]) / d[a];
+        if (ta > tb) std::swap(ta, tb);
+        tIn = std::max(tIn, ta);
+        tOut = std::min(tOut, tb);
+    }
+    return tIn <= tOut;
+}
+
+// Walks the cells crossed by p0 + t*d, t in [0,1], in order and calls
+// visit(cx, cy, tExit) until it returns false. The walk covers the grid
+// plus 'ring' cells around it (walls straddle the border, casts have a
+// radius); cell indices outside the grid are the caller's to clamp.
+template <class Visit>
+static void WalkCells(const WallGrid& g, float px, float py, float dx, float dy,
+                      int ring, Visit&& visit)
+{
+    const float x0 = g.originX - ring * g.cellW, x1 = g.originX + (g.cols + ring) * g.cellW;
+    const float y0 = g.originY - ring * g.cellH, y1 = g.originY + (g.rows + ring) * g.cellH;
+    float tIn, tOut;
+    if (!ClipSegment(px, py, dx, dy, x0, y0, x1, y1, tIn, tOut)) return;
+
+    const float sx = px + dx * tIn, sy = py + dy * tIn;
+    int ix = std::clamp(int(std::floor((sx - g.originX) / g.cellW)), -ring, g.cols + ring - 1);
+    int iy = std::clamp(int(std::floor((sy - g.originY) / g.cellH)), -ring, g.rows + ring - 1);
+
+    constexpr float kInf = std::numeric_limits<float>::infinity();
+    const int stepX = dx > 0.f ? 1 : (dx < 0.f ? -1 : 0);
+    const int stepY = dy > 0.f ? 1 : (dy < 0.f ? -1 : 0);
+    float tMaxX = stepX == 0 ? kInf : (g.originX + (ix + (stepX > 0)) * g.cellW - px) / dx;
+    float tMaxY = stepY == 0 ? kInf : (g.originY + (iy + (stepY > 0)) * g.cellH - py) / dy;
+    const float tDeltaX = stepX == 0 ? kInf : g.cellW / std::fabs(dx);
+    const float tDeltaY = stepY == 0 ? kInf : g.cellH / std::fabs(dy);
+
+    // a straight line crosses each row and column at most once
+    const int maxSteps = g.cols + g.rows + 4 * ring + 4;
+    for (int s = 0; s <= maxSteps; ++s) {
+        const float tExit = std::min(std::min(tMaxX, tMaxY), tOut);
+        if (!visit(ix, iy, tExit) || tExit >= tOut) return;
+        if (tMaxX < tMaxY) { ix += stepX; tMaxX += tDeltaX; }
+        else               { iy += stepY; tMaxY += tDeltaY; }
+    }
+}
+
+// Per-thread "tested this query" marks, so a wall listed in several
+// crossed cells is only tested once.
+struct WallMarks {
+    std::vector<uint32_t> stamp;
+    uint32_t current = 0;
+
+    void Begin(size_t walls) {
+        if (stamp.size() < walls) stamp.resize(walls, 0);
+        if (++current == 0) { std::fill(stamp.begin(), stamp.end(), 0u); current = 1; }
+    }
+    bool First(uint32_t w) {
+        if (stamp[w] == current) return false;
+        stamp[w] = current;
+        return true;
+    }
+};
+
+// Runs test(wall) over the walls the cast may reach, cell by cell along the
+// path when the maze has a grid. test keeps the best t; 'best' is read to
+// stop at the first cell that holds a hit.
+template <class Test>
+static void CastWalls(const Maze& maze, float px, float py, float dx, float dy,
+                      float radius, const float& best, Test&& test)
+{
+    const WallGrid& g = maze.grid;
+    if (g.Empty()) {
+        for (uint32_t wi = 0; wi < uint32_t(maze.soa.count); ++wi) test(wi);
+        return;
+    }
+
+    thread_local WallMarks s_Marks;
+    s_Marks.Begin(maze.soa.count);
+
+    // cells around the path a circle of this radius can reach
+    const int reach = radius > 0.f ? int(std::ceil(radius / std::min(g.cellW, g.cellH))) : 0;
+    WalkCells(g, px, py, dx, dy, 1 + reach, [&](int cx, int cy, float tExit) {
+        const int ax = std::clamp(cx - reach, 0, g.cols - 1), bx = std::clamp(cx + reach, 0, g.cols - 1);
+        const int ay = std::clamp(cy - reach, 0, g.rows - 1), by = std::clamp(cy + reach, 0, g.rows - 1);
+        for (int y = ay; y <= by; ++y) {
+            for (int x = ax; x <= bx; ++x) {
+                const size_t c = size_t(y) * size_t(g.cols) + size_t(x);
+                for (uint32_t k = g.cellStart[c]; k < g.cellStart[c + 1]; ++k) {
+                    const uint32_t wi = g.indices[k];
+                    if (s_Marks.First(wi)) test(wi);
+                }
+            }
+        }
+        // anything hit later than this cell is found again further on
+        return best > tExit;
+    });
+}
+
+static inline bool UnitDir(const TwoBlade& line, float& ux, float& uy)
+{
+    const float n = std::sqrt(line[3] * line[3] + line[4] * line[4]);
+    if (n < 1e-12f) return false;
+    ux = line[3] / n; uy = line[4] / n;
+    return true;
+}
+
+static bool Cast(const Maze& maze, float ox, float oy, float dirX, float dirY,
+                 float radius, float maxDist, RayHit& hit)
+{
+    hit = RayHit{};
+    hit.t = std::max(maxDist, 0.f);
+    hit.x = ox; hit.y = oy;
+
+    const float n = std::sqrt(dirX * dirX + dirY * dirY);
+    if (n < 1e-12f || maxDist <= 0.f) return false;
+    const float dx = dirX / n * maxDist, dy = dirY / n * maxDist;
+    hit.x = ox + dx; hit.y = oy + dy;
+    if (maze.soa.Empty()) return false;
+
+    float best = 1.f, bnx = 0.f, bny = 0.f;
+    uint32_t bw = RayHit::kNoWall;
+    CastWalls(maze, ox, oy, dx, dy, radius, best, [&](uint32_t wi) {
+        float nx, ny;
+        const bool closer = radius > 0.f
+            ? MazeQuery::CircleWall(maze, wi, ox, oy, dx, dy, radius, best, nx, ny)
+            : MazeQuery::SegmentWall(maze, wi, ox, oy, dx, dy, best, nx, ny);
+        if (closer) { bnx = nx; bny = ny; bw = wi; }
+    });
+    if (bw == RayHit::kNoWall) return false;
+
+    hit.t = best * maxDist;
+    hit.x = ox + dx * best; hit.y = oy + dy * best;
+    hit.nx = bnx; hit.ny = bny;
+    hit.wall = bw;
+    return true;
+}
+
+bool MazeQuery::Raycast(const Maze& maze, float ox, float oy, float dirX, float dirY,
+                        float maxDist, RayHit& hit)
+{
+    return Cast(maze, ox, oy, dirX, dirY, 0.f, maxDist, hit);
+}
+
+bool MazeQuery::Raycast(const Maze& maze, const ThreeBlade& from, const TwoBlade& line,
+                        float maxDist, RayHit& hit)
+{
+    float ux = 0.f, uy = 0.f;
+    if (!UnitDir(line, ux, uy)) { hit = RayHit{}; hit.x = from[0]; hit.y = from[1]; return false; }
+    return Cast(maze, from[0], from[1], ux, uy, 0.f, maxDist, hit);
+}
+
+bool MazeQuery::CircleCast(const Maze& maze, float ox, float oy, float dirX, float dirY,
+                           float radius, float maxDist, RayHit& hit)
+{
+    return Cast(maze, ox, oy, dirX, dirY, std::max(radius, 0.f), maxDist, hit);
+}
+
+bool MazeQuery::CircleCast(const Maze& maze, const ThreeBlade& from, const TwoBlade& line,
+                           float radius, float maxDist, RayHit& hit)
+{
+    float ux = 0.f, uy = 0.f;
+    if (!UnitDir(line, ux, uy)) { hit = RayHit{}; hit.x = from[0]; hit.y = from[1]; return false; }
+    return Cast(maze, from[0], from[1], ux, uy, std::max(radius, 0.f), maxDist, hit);
+}
+
+bool MazeQuery::LineOfSight(const Maze& maze, const ThreeBlade& A, const ThreeBlade& B)
+{
+    TwoBlade L = A & B;
+    const float d = L.Norm();
+    if (d < 1e-6f) return true;
+    RayHit hit;
+    return !Raycast(maze, A, L, d, hit);
+}
+
+void MazeQuery::RaycastBatch(const Maze& maze, const ThreeBlade& from,
+                             const TwoBlade* lines, size_t count, float maxDist,
+                             RayHit* out, JobSystem* jobs)
+{
+    auto range = [&](size_t b, size_t e) {
+        for (size_t i = b; i < e; ++i) Raycast(maze, from, lines[i], maxDist, out[i]);
+    };
+    if (jobs && jobs->WorkerCount() > 0) jobs->ParallelFor(count, 64, range);
+    else range(0, count);
+}
+
+TwoBlade MazeQuery::LineAt(const ThreeBlade& P, float angle)
+{
+    return P & ThreeBlade(P[0] + std::cos(angle), P[1] + std::sin(angle), 0.f);
+}
+
+bool MazeQuery::SegmentWall(const Maze& maze, uint32_t wall, float x0, float y0,
+                            float dx, float dy, float& t, float& nx, float& ny)
+{
+    float tt, hx, hy;
+    if (!RayBox(x0, y0, dx, dy, maze.soa.minX[wall], maze.soa.minY[wall],
+                maze.soa.maxX[wall], maze.soa.maxY[wall], tt, hx, hy) || tt >= t)
+        return false;
+    t = tt; nx = hx; ny = hy;
+    return true;
+}
+
+bool MazeQuery::CircleWall(const Maze& maze, uint32_t wall, float x0, float y0,
+                           float dx, float dy, float radius,
+                           float& t, float& nx, float& ny)
+{
+    if (t <= 0.f) return false;
+
+    const float wx0 = maze.soa.minX[wall], wy0 = maze.soa.minY[wall];
+    const float wx1 = maze.soa.maxX[wall], wy1 = maze.soa.maxY[wall];
+
+    // already touching: a hit right away if the move goes further in
+    const float qx = x0 - std::clamp(x0, wx0, wx1);
+    const float qy = y0 - std::clamp(y0, wy0, wy1);
+    if (qx*qx + qy*qy <= radius * radius) {
+        const WallContact c = maze.soa.Contact(wall, x0, y0, radius);
+        if (dx * c.nx + dy * c.ny >= 0.f) return false;
+        t = 0.f; nx = c.nx; ny = c.ny;
+        return true;
+    }
+
+    // the rounded box: two slabs grown by the radius + four corner circles
+    bool found = false;
+    float tt, hx, hy;
+    if (RayBox(x0, y0, dx, dy, wx0 - radius, wy0, wx1 + radius, wy1, tt, hx, hy) && tt < t) {
+        t = tt; nx = hx; ny = hy; found = true;
+    }
+    if (RayBox(x0, y0, dx, dy, wx0, wy0 - radius, wx1, wy1 + radius, tt, hx, hy) && tt < t) {
+        t = tt; nx = hx; ny = hy; found = true;
+    }
+    const float cxs[2] = { wx0, wx1 }, cys[2] = { wy0, wy1 };
+    for (float cx : cxs) {
+        for (float cy : cys) {
+            if (RayCircle(x0, y0, dx, dy, cx, cy, radius, tt) && tt < t) {
+                t = tt;
+                nx = (x0 + dx * tt - cx) / radius;
+                ny = (y0 + dy * tt - cy) / radius;
+                found = true;
+            }
+        }
+    }
+    return found;
+}
+
+} // namespace gameplay
@@ -0,0 +1,65 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+#include "../FlyFish.h"
+#include "Gameplay/Maze.h"
+
+namespace gameplay {
+
+    class JobSystem;
+
+    struct RayHit {
+        static constexpr uint32_t kNoWall = ~0u;
+
+        float    t = 0.f;            // distance along the ray (maxDist on a miss)
+        float    x = 0.f, y = 0.f;   // hit point, the circle's centre for casts
+        float    nx = 0.f, ny = 0.f; // wall normal facing the ray
+        uint32_t wall = kNoWall;
+
+        bool Hit() const { return wall != kNoWall; }
+    };
+
+    // Ray and circle casts against a maze's walls.
+    //
+    // Rays are PGA lines: 'line' is any line through 'from' (A & B for the
+    // segment A->B), its direction taken from the e23/e31 part like the rest
+    // of the code does. The walk follows the maze's WallGrid cell by cell
+    // (Amanatides-Woo DDA) and only tests walls listed in the cells it
+    // crosses, stopping at the first cell that contains a hit; mazes without
+    // a grid are tested wall by wall. Walls containing the start point are
+    // ignored by Raycast; CircleCast reports them at t = 0 when the cast
+    // heads into them, like CollisionSystemMaze::SweepCircle.
+    struct MazeQuery {
+        static bool Raycast(const Maze& maze, const ThreeBlade& from, const TwoBlade& line,
+                            float maxDist, RayHit& hit);
+        static bool Raycast(const Maze& maze, float ox, float oy, float dirX, float dirY,
+                            float maxDist, RayHit& hit);
+
+        static bool CircleCast(const Maze& maze, const ThreeBlade& from, const TwoBlade& line,
+                               float radius, float maxDist, RayHit& hit);
+        static bool CircleCast(const Maze& maze, float ox, float oy, float dirX, float dirY,
+                               float radius, float maxDist, RayHit& hit);
+
+        // no wall between A and B
+        static bool LineOfSight(const Maze& maze, const ThreeBlade& A, const ThreeBlade& B);
+
+        // Many rays from one eye (visibility sampling): out[i] for lines[i].
+        // Spread over the job system's workers when one is given.
+        static void RaycastBatch(const Maze& maze, const ThreeBlade& from,
+                                 const TwoBlade* lines, size_t count, float maxDist,
+                                 RayHit* out, JobSystem* jobs = nullptr);
+
+        // line through P at 'angle' radians, for building ray fans
+        static TwoBlade LineAt(const ThreeBlade& P, float angle);
+
+        // Narrowphase on one wall, t in [0,1] along (dx,dy); true when
+        // the wall is hit earlier than the t passed in.
+        static bool SegmentWall(const Maze& maze, uint32_t wall, float x0, float y0,
+                                float dx, float dy, float& t, float& nx, float& ny);
+        static bool CircleWall(const Maze& maze, uint32_t wall, float x0, float y0,
+                               float dx, float dy, float radius,
+                               float& t, float& nx, float& ny);
+    };
+
+} // namespace gameplay
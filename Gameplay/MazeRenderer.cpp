@@ -27,15 +27,24 @@ namespace gameplay {
         glEnd();
     }
 
-    void MazeRenderer::Draw(const Maze& m)
+    void MazeRenderer::DrawWalls(const Maze& m)
     {
-        // walls
         glColor4f(0.9f, 0.85f, 0.7f, 0.8f);
         for (const auto& w : m.walls) DrawRect(w.x, w.y, w.w, w.h);
+    }
+
+    void MazeRenderer::Draw(const Maze& m, bool endInSight)
+    {
+        // walls
+        DrawWalls(m);
 
         // end point ring
         glColor4f(0.2f, 1.0f, 0.4f, 1.0f);
         DrawCircle(m.endCenter[0], m.endCenter[1], m.endRadius);
+        if (endInSight) {
+            glColor4f(0.2f, 1.0f, 0.4f, 0.5f);
+            DrawCircle(m.endCenter[0], m.endCenter[1], m.endRadius + 5.f);
+        }
     }
 
 } // namespace gameplay
@@ -3,6 +3,10 @@
 
 namespace gameplay {
     struct MazeRenderer {
-        static void Draw(const Maze& m);
+        // endInSight: a second ring marks the end as visible from the player
+        static void Draw(const Maze& m, bool endInSight = false);
+
+        // walls only, no end ring (world tiles)
+        static void DrawWalls(const Maze& m);
     };
 } // namespace gameplay
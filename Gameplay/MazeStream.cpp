@@ -0,0 +1,86 @@
+#include "Gameplay/MazeStream.h"
+#include <algorithm>
+#include <cmath>
+
+#include "Gameplay/CollisionSystemMaze.h"
+
+namespace gameplay {
+
+void MazeStream::Reset(const MazeGenerator::BandParams& params, int liveBands)
+{
+    m_Params = params;
+    m_Params.cols     = std::max(2, m_Params.cols);
+    m_Params.bandRows = std::max(1, m_Params.bandRows);
+
+    m_Ring.clear();
+    m_Ring.resize(size_t(std::max(2, liveBands)));
+}
+
+size_t MazeStream::Slot(int64_t band) const
+{
+    const int64_t n = int64_t(m_Ring.size());
+    return size_t(((band % n) + n) % n);
+}
+
+int64_t MazeStream::BandAt(float y) const
+{
+    return int64_t(std::floor((y - m_Params.originY) / BandHeight()));
+}
+
+int MazeStream::Update(float minY, float maxY)
+{
+    if (m_Ring.empty()) return 0;
+    if (maxY < minY) std::swap(minY, maxY);
+
+    int64_t lo = BandAt(minY);
+    int64_t hi = BandAt(maxY);
+
+    // more wanted than fits: keep the ones around the middle
+    const int64_t n = int64_t(m_Ring.size());
+    if (hi - lo + 1 > n) {
+        const int64_t mid = (lo + hi) / 2;
+        lo = mid - (n - 1) / 2;
+        hi = lo + n - 1;
+    }
+
+    int generated = 0;
+    for (int64_t b = lo; b <= hi; ++b) {
+        Chunk& c = m_Ring[Slot(b)];
+        if (c.band == b) continue;
+        MazeGenerator::GenerateBand(c.maze, m_Params, b);   // reuses the slot's buffers
+        c.band = b;
+        ++generated;
+    }
+    return generated;
+}
+
+const Maze* MazeStream::Band(int64_t band) const
+{
+    if (m_Ring.empty()) return nullptr;
+    const Chunk& c = m_Ring[Slot(band)];
+    return c.band == band ? &c.maze : nullptr;
+}
+
+void MazeStream::Resolve(ThreeBlade& X, float& vx, float& vy, float radius, float bounceLoss) const
+{
+    // a circle near a seam touches the band below's north walls as well
+    const float reach = radius + m_Params.wallThickness;
+    const int64_t b0 = BandAt(X[1] - reach), b1 = BandAt(X[1] + reach);
+    for (int64_t b = b0; b <= b1; ++b) {
+        if (const Maze* m = Band(b))
+            CollisionSystemMaze::Resolve(*m, X, vx, vy, radius, bounceLoss);
+    }
+}
+
+bool MazeStream::CircleOverlapsAnyWall(float cx, float cy, float r) const
+{
+    const float reach = r + m_Params.wallThickness;
+    const int64_t b0 = BandAt(cy - reach), b1 = BandAt(cy + reach);
+    for (int64_t b = b0; b <= b1; ++b) {
+        const Maze* m = Band(b);
+        if (m && CollisionSystemMaze::CircleOverlapsAnyWall(*m, cx, cy, r)) return true;
+    }
+    return false;
+}
+
+} // namespace gameplay
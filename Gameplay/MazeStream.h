@@ -0,0 +1,54 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "Gameplay/MazeGenerator.h"
+
+namespace gameplay {
+
+    // Endless maze in +/-y built from MazeGenerator::GenerateBand.
+    // A fixed ring of bands stays resident around the rows being looked at;
+    // bands that scroll out are overwritten in place by the ones scrolling
+    // in, so memory is O(cols * bandRows * liveBands) however far you go.
+    class MazeStream {
+    public:
+        void Reset(const MazeGenerator::BandParams& params, int liveBands = 4);
+
+        // Makes the bands covering [minY, maxY] resident (clipped to the ring
+        // size around the middle). Returns how many bands were generated.
+        int Update(float minY, float maxY);
+
+        // nullptr when the band is not resident
+        const Maze* Band(int64_t band) const;
+        int64_t BandAt(float y) const;
+
+        const MazeGenerator::BandParams& Params() const { return m_Params; }
+        int LiveCount() const { return int(m_Ring.size()); }
+
+        // resident bands in ring order
+        template <class Fn>
+        void ForEachLive(Fn&& fn) const {
+            for (const auto& c : m_Ring)
+                if (c.band != kNoBand) fn(c.band, c.maze);
+        }
+
+        // collision against the resident bands the circle can touch
+        void Resolve(ThreeBlade& X, float& vx, float& vy, float radius, float bounceLoss) const;
+        bool CircleOverlapsAnyWall(float cx, float cy, float r) const;
+
+    private:
+        static constexpr int64_t kNoBand = INT64_MIN;
+
+        struct Chunk {
+            int64_t band = kNoBand;
+            Maze    maze;
+        };
+
+        size_t Slot(int64_t band) const;
+        float  BandHeight() const { return float(m_Params.bandRows) * m_Params.cellH; }
+
+        MazeGenerator::BandParams m_Params;
+        std::vector<Chunk> m_Ring;   // slot = band mod ring size
+    };
+
+} // namespace gameplay
@@ -1,8 +1,11 @@
 #include "Gameplay/MovablePillar.h"
 #include <algorithm>
 #include <cmath>
+#include <utility>
 
 #include "GeoMotors.h"
+#include "Gameplay/Broadphase.h"
+#include "Gameplay/CollisionSystemMaze.h"
 
 namespace gameplay {
     MovablePillar MovablePillar::MakeLinear(const ThreeBlade &start, float vx_, float vy_, float influence) {
@@ -48,19 +51,9 @@ namespace gameplay {
                 break;
             }
             case Mode::Orbit: {
-                TwoBlade L = C & anchor;
-                float R = L.Norm();
-                if (R > 1e-6f) {
-                    const float rx = L[3] / R;
-                    const float ry = L[4] / R;
-                    const float tx = -ry;
-                    const float ty = rx;
-                    const float speed = std::fabs(omega) * R;
-                    const float dir = (omega >= 0.f) ? 1.f : -1.f;
-
-                    Motor T = GeoMotors::MakeTranslator(dir * speed * tx * dt, dir * speed * ty * dt);
-                    C = GeoMotors::Apply(C, T);
-                }
+                // closed form: exact for any dt, so coarse steps stay on the circle
+                Motor R = GeoMotors::MakeRotationAboutPoint(anchor, -omega * dt);
+                C = GeoMotors::Apply(C, R);
                 break;
             }
             case Mode::Seek: {
@@ -92,6 +85,105 @@ namespace gameplay {
         BounceInside(minX, minY, maxX, maxY, bounceLoss);
     }
 
+    void MovablePillar::Velocity(float &outVx, float &outVy) const {
+        outVx = vx;
+        outVy = vy;
+        if (mode != Mode::Orbit) return;
+
+        outVx = outVy = 0.f;
+        TwoBlade L = C & anchor;
+        if (L.Norm() > 1e-6f) {
+            // omega * R along the tangent (-ry, rx), r the unit direction to the anchor
+            outVx = -omega * L[4];
+            outVy =  omega * L[3];
+        }
+    }
+
+    bool MovablePillar::Resting(float minSpeed) const {
+        float ux, uy;
+        Velocity(ux, uy);
+        if (ux * ux + uy * uy >= minSpeed * minSpeed) return false;
+        // a seeker short of its target is about to accelerate
+        return mode != Mode::Seek || (C & target).Norm() <= radius;
+    }
+
+    void MovablePillar::Bounce(float newVx, float newVy) {
+        if (mode == Mode::Linear || mode == Mode::Seek) {
+            vx = newVx;
+            vy = newVy;
+        } else if (mode == Mode::Orbit) {
+            float ox, oy;
+            Velocity(ox, oy);
+            if (newVx * ox + newVy * oy < 0.f) omega = -omega;
+        }
+    }
+
+    bool MovablePillar::CollideWalls(const Maze &maze, float bounceLoss) {
+        float ux, uy;
+        Velocity(ux, uy);
+
+        ContactStats stats;
+        CollisionSystemMaze::Resolve(maze, C, ux, uy, radius, bounceLoss, &stats);
+        if (stats.solves == 0) return false;
+
+        Bounce(ux, uy);
+        return true;
+    }
+
+    size_t MovablePillar::CollidePillars(std::vector<MovablePillar> &pillars, SweepAndPrune &sap,
+                                         float bounceLoss, const Maze *maze, const uint8_t *moved) {
+        thread_local std::vector<std::pair<uint32_t, uint32_t>> pairs;
+        thread_local std::vector<uint8_t> pushed;
+
+        const size_t n = pillars.size();
+        sap.Resize(n);
+        for (size_t i = 0; i < n; ++i)
+            sap.SetCircle(uint32_t(i), pillars[i].C[0], pillars[i].C[1], pillars[i].radius);
+        sap.Update();
+        sap.Pairs(pairs);
+
+        pushed.assign(n, 0);
+        size_t touching = 0;
+        for (const auto &[ia, ib] : pairs) {
+            if (moved && !moved[ia] && !moved[ib]) continue;
+            MovablePillar &a = pillars[ia];
+            MovablePillar &b = pillars[ib];
+
+            TwoBlade L = a.C & b.C;   // a -> b
+            const float d = L.Norm();
+            const float rs = a.radius + b.radius;
+            if (d >= rs) continue;
+            ++touching;
+
+            float nx = 1.f, ny = 0.f;
+            if (d > 1e-6f) { nx = L[3] / d; ny = L[4] / d; }
+
+            // split the overlap evenly
+            const float h = 0.5f * (rs - d);
+            a.C = GeoMotors::Apply(a.C, GeoMotors::MakeTranslator(-nx * h, -ny * h));
+            b.C = GeoMotors::Apply(b.C, GeoMotors::MakeTranslator( nx * h,  ny * h));
+            pushed[ia] = pushed[ib] = 1;
+
+            float avx, avy, bvx, bvy;
+            a.Velocity(avx, avy);
+            b.Velocity(bvx, bvy);
+            const float vn = (bvx - avx) * nx + (bvy - avy) * ny;
+            if (vn >= 0.f) continue;   // already separating
+
+            const float j = -(1.f + bounceLoss) * vn * 0.5f;
+            a.Bounce(avx - j * nx, avy - j * ny);
+            b.Bounce(bvx + j * nx, bvy + j * ny);
+        }
+
+        if (maze) {
+            for (size_t i = 0; i < n; ++i) {
+                if (!pushed[i]) continue;
+                CollisionSystemMaze::DepenetratePosition(*maze, pillars[i].C, pillars[i].radius, 4);
+            }
+        }
+        return touching;
+    }
+
     void MovablePillar::BounceInside(float minX, float minY, float maxX, float maxY, float bounceLoss) {
         bool hitX = false, hitY = false;
         float x = C[0], y = C[1];
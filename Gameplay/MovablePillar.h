@@ -1,13 +1,18 @@
 // Gameplay/MovablePillar.h
 #pragma once
+#include <cstdint>
+#include <vector>
 #include "FlyFish.h"
 
-
 namespace gameplay {
 
+    struct Maze;
+    class SweepAndPrune;
+
     struct MovablePillar
     {
         ThreeBlade C;
+        float radius = 7.f;   // body, for walls and other pillars
 
         float influenceR = 240.f;
         float gravAccel  = 220.f;
@@ -30,10 +35,33 @@ namespace gameplay {
         static MovablePillar MakeOrbit (const ThreeBlade& anchor, const ThreeBlade& startOnCircle, float omega, float influence = 240.f);
         static MovablePillar MakeSeek  (const ThreeBlade& start, const ThreeBlade& target, float maxSpeed, float accel, float influence = 240.f);
 
+        // Orbit turns about the anchor in closed form, any dt lands on the circle
         void Step(float dt);
 
         void Step(float dt, float minX, float minY, float maxX, float maxY, float bounceLoss = 1.0f);
 
+        // current velocity; Orbit's is the tangent of its circle
+        void Velocity(float& outVx, float& outVy) const;
+
+        // slower than minSpeed and not about to speed up
+        bool Resting(float minSpeed) const;
+
+        // takes the velocity a collision left: Linear/Seek keep it,
+        // Orbit turns around like it does at the window edge
+        void Bounce(float newVx, float newVy);
+
+        // pushes the body out of the maze walls; true on contact
+        bool CollideWalls(const Maze& maze, float bounceLoss);
+
+        // Pillar vs pillar through the broadphase (equal masses), then the
+        // pushed bodies are cleared of 'maze' walls again. With 'moved'
+        // (one flag per pillar), pairs where neither pillar moved since the
+        // last call are skipped - they were separated then. Returns the
+        // number of touching pairs.
+        static size_t CollidePillars(std::vector<MovablePillar>& pillars, SweepAndPrune& sap,
+                                     float bounceLoss, const Maze* maze = nullptr,
+                                     const uint8_t* moved = nullptr);
+
     private:
         void BounceInside(float minX, float minY, float maxX, float maxY, float bounceLoss);
     };
@@ -0,0 +1,72 @@
+#include "Gameplay/MoverScheduler.h"
+#include <algorithm>
+#include <cmath>
+
+namespace gameplay {
+
+void MoverScheduler::Reset()
+{
+    m_Pending.clear();
+    m_Due.clear();
+    m_DueDt.clear();
+    m_Stepped.clear();
+    m_Frame = 0;
+}
+
+void MoverScheduler::Schedule(const std::vector<MovablePillar>& movers,
+                              float minX, float minY, float maxX, float maxY, float dt)
+{
+    const size_t n = movers.size();
+    if (m_Pending.size() != n) m_Pending.assign(n, 0.f);
+    m_Due.clear();
+    m_DueDt.clear();
+    m_Stepped.assign(n, 0);
+
+    const float nearSq = settings.viewMargin * settings.viewMargin;
+    const float farSq  = settings.farMargin * settings.farMargin;
+    size_t sleeping = 0, coarse = 0;
+
+    for (size_t i = 0; i < n; ++i) {
+        const MovablePillar& mp = movers[i];
+        // squared distance to the view rect, 0 on screen
+        const float x = mp.C[0], y = mp.C[1];
+        const float dx = std::max({ minX - x, 0.f, x - maxX });
+        const float dy = std::max({ minY - y, 0.f, y - maxY });
+        const float d2 = dx * dx + dy * dy;
+
+        if (d2 > farSq && mp.Resting(settings.sleepSpeed)) {
+            m_Pending[i] = 0.f;   // nothing moves while asleep
+            ++sleeping;
+            continue;
+        }
+
+        float& pending = m_Pending[i];
+        pending += dt;
+
+        int interval = d2 <= nearSq ? 1 : d2 <= farSq ? settings.midInterval : settings.farInterval;
+        bool due = interval <= 1 || (m_Frame + i) % uint64_t(interval) == 0;
+        if (!due) {
+            // step early rather than let the skipped time carry it through a wall
+            float ux, uy;
+            mp.Velocity(ux, uy);
+            const float reach = std::sqrt(ux * ux + uy * uy) * (pending + dt);
+            due = reach > settings.maxTravel;
+        }
+        if (!due) continue;
+
+        if (pending > dt * 1.5f) ++coarse;
+        m_Due.push_back(uint32_t(i));
+        m_DueDt.push_back(pending);
+        m_Stepped[i] = 1;
+        pending = 0.f;
+    }
+
+    ++m_Frame;
+    m_Stats.frames++;
+    m_Stats.movers   += n;
+    m_Stats.stepped  += m_Due.size();
+    m_Stats.coarse   += coarse;
+    m_Stats.sleeping += sleeping;
+}
+
+} // namespace gameplay
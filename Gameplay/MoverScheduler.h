@@ -0,0 +1,72 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Gameplay/MovablePillar.h"
+
+namespace gameplay {
+
+    // Update LOD for movable pillars: which movers step this frame, and by
+    // how much time.
+    //
+    // Movers on screen (or just off it) step every frame. Further out of
+    // view they step every few frames with the time they skipped (Orbit is
+    // closed form, so the coarse step lands on the same circle); the steps
+    // are staggered by index so the far movers don't all come due on one
+    // frame. A coarse step never moves a mover more than maxTravel, so walls
+    // still stop it. Far movers at rest sleep - not stepped, not collided
+    // with walls - until the view comes within farMargin or a collision gets
+    // them moving again. Pillar pairs where neither side stepped can be
+    // skipped too (CollidePillars with Stepped()).
+    class MoverScheduler {
+    public:
+        struct Settings {
+            // distances outside the view rect
+            float viewMargin  = 200.f;   // every frame inside this
+            float farMargin   = 900.f;   // farInterval beyond it, midInterval between
+            int   midInterval = 2;
+            int   farInterval = 6;
+            float maxTravel   = 12.f;    // per coarse step
+            float sleepSpeed  = 0.5f;    // far movers slower than this sleep
+        };
+
+        struct Stats {
+            size_t frames = 0;
+            size_t movers = 0;     // summed over frames
+            size_t stepped = 0;
+            size_t coarse = 0;     // steps covering more than one frame
+            size_t sleeping = 0;
+
+            double SteppedPerFrame() const { return frames ? double(stepped) / double(frames) : 0.0; }
+        };
+
+        Settings settings;
+
+        // Picks this frame's steps for 'movers' against the view rect
+        // [minX, maxX] x [minY, maxY]; read them back with Due()/DueDt().
+        // A different mover count starts over.
+        void Schedule(const std::vector<MovablePillar>& movers,
+                      float minX, float minY, float maxX, float maxY, float dt);
+
+        const std::vector<uint32_t>& Due()   const { return m_Due; }
+        const std::vector<float>&    DueDt() const { return m_DueDt; }
+        // one flag per mover, set for the due ones; for CollidePillars
+        const uint8_t* Stepped() const { return m_Stepped.data(); }
+
+        // forget skipped time, e.g. after a level load
+        void Reset();
+
+        const Stats& GetStats() const { return m_Stats; }
+        void ResetStats() { m_Stats = {}; }
+
+    private:
+        std::vector<float>    m_Pending;   // time skipped since each mover's last step
+        std::vector<uint32_t> m_Due;
+        std::vector<float>    m_DueDt;
+        std::vector<uint8_t>  m_Stepped;
+        uint64_t m_Frame = 0;
+        Stats    m_Stats;
+    };
+
+} // namespace gameplay
@@ -0,0 +1,315 @@
+#include "Gameplay/PackedMaze.h"
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <random>
+
+#include "Gameplay/JobSystem.h"
+#include "Gameplay/SeedMix.h"
+
+namespace gameplay {
+
+void PackedMaze::Generate(int cols, int rows, uint32_t seed)
+{
+    cols = std::max(2, cols);
+    rows = std::max(2, rows);
+
+    std::mt19937 rng;
+    if (seed == 0) {
+        std::random_device rd;
+        rng.seed(rd());
+    } else {
+        rng.seed(seed);
+    }
+
+    m_Cols = cols;
+    m_Rows = rows;
+    const size_t cells = CellCount();
+
+    // all walls up, nothing visited; assign() reuses capacity
+    m_Walls.assign((cells + 31) / 32, ~uint64_t(0));
+    m_Visited.assign((cells + 63) / 64, 0);
+
+    // The stack never holds more than cells-1 entries. Each entry is the
+    // direction back to the parent (4 per byte) rather than a cell index, so
+    // the current cell is walked back instead of being stored.
+    if (m_Back.size() < (cells + 3) / 4) m_Back.resize((cells + 3) / 4);
+    size_t depth = 0;
+
+    auto push = [&](int dir) {
+        uint8_t& b = m_Back[depth >> 2];
+        const int sh = int(depth & 3) * 2;
+        b = uint8_t((b & ~(3 << sh)) | (dir << sh));
+        ++depth;
+    };
+    auto pop = [&]() {
+        --depth;
+        return (m_Back[depth >> 2] >> (int(depth & 3) * 2)) & 3;
+    };
+
+    const size_t stride = size_t(cols);
+    int x = 0, y = 0;
+    size_t cur = 0;
+    MarkVisited(cur);
+
+    for (;;) {
+        // unvisited neighbours in a fixed array; a uniform pick among them is
+        // the same as shuffling all four and taking the first unvisited one
+        int dirs[4];
+        int n = 0;
+        if (y + 1 < rows && !Visited(cur + stride)) dirs[n++] = N;
+        if (x + 1 < cols && !Visited(cur + 1))      dirs[n++] = E;
+        if (y > 0        && !Visited(cur - stride)) dirs[n++] = S;
+        if (x > 0        && !Visited(cur - 1))      dirs[n++] = W;
+
+        if (n == 0) {
+            if (depth == 0) break;
+            switch (pop()) {
+                case N: ++y; cur += stride; break;
+                case E: ++x; cur += 1;      break;
+                case S: --y; cur -= stride; break;
+                case W: --x; cur -= 1;      break;
+            }
+            continue;
+        }
+
+        const int d = dirs[n == 1 ? 0 : int((uint64_t(rng()) * uint64_t(n)) >> 32)];
+        switch (d) {
+            case N: ClearWallBit(cur, 0);          ++y; cur += stride; break;
+            case E: ClearWallBit(cur, 1);          ++x; cur += 1;      break;
+            case S: ClearWallBit(cur - stride, 0); --y; cur -= stride; break;
+            case W: ClearWallBit(cur - 1, 1);      --x; cur -= 1;      break;
+        }
+        MarkVisited(cur);
+        push((d + 2) % 4);
+    }
+
+    // random end cell != (0,0)
+    std::uniform_int_distribution<int> distX(0, cols - 1);
+    std::uniform_int_distribution<int> distY(0, rows - 1);
+    do {
+        m_EndX = distX(rng);
+        m_EndY = distY(rng);
+    } while (m_EndX == 0 && m_EndY == 0);
+}
+
+void PackedMaze::Assign(int cols, int rows, const uint8_t* cellWalls)
+{
+    m_Cols = std::max(0, cols);
+    m_Rows = std::max(0, rows);
+    const size_t cells = CellCount();
+
+    m_Walls.assign((cells + 31) / 32, 0);
+    m_Visited.assign((cells + 63) / 64, 0);
+    for (size_t c = 0; c < cells; ++c) {
+        const uint64_t ne = cellWalls[c] & 3u;   // N, E
+        m_Walls[c >> 5] |= ne << ((c & 31) * 2);
+    }
+    m_EndX = std::max(0, m_Cols - 1);
+    m_EndY = std::max(0, m_Rows - 1);
+}
+
+bool PackedMaze::HasWall(int x, int y, int dir) const
+{
+    const size_t cell = size_t(y) * size_t(m_Cols) + size_t(x);
+    switch (dir) {
+        case N: return WallBit(cell, 0);
+        case E: return WallBit(cell, 1);
+        case S: return y == 0 ? x != 0 : WallBit(cell - size_t(m_Cols), 0);
+        case W: return x == 0 ? true   : WallBit(cell - 1, 1);
+    }
+    return true;
+}
+
+size_t PackedMaze::MemoryBytes() const
+{
+    return m_Walls.capacity() * sizeof(uint64_t)
+         + m_Visited.capacity() * sizeof(uint64_t)
+         + m_Back.capacity();
+}
+
+static inline uint32_t RegionSeed(uint32_t seed, uint64_t region)
+{
+    return uint32_t(SplitMix64((uint64_t(seed) << 32) ^ region)) | 1u;
+}
+
+void PackedMaze::GenerateParallel(int cols, int rows, uint32_t seed,
+                                  int regionSize, JobSystem* jobs)
+{
+    cols = std::max(2, cols);
+    rows = std::max(2, rows);
+    regionSize = std::max(2, regionSize);
+
+    std::mt19937 rng;
+    if (seed == 0) {
+        std::random_device rd;
+        rng.seed(rd());
+    } else {
+        rng.seed(seed);
+    }
+    const uint32_t base = rng();
+
+    m_Cols = cols;
+    m_Rows = rows;
+    const size_t cells = CellCount();
+    m_Walls.assign((cells + 31) / 32, ~uint64_t(0));
+    m_Visited.clear();   // the regions carve on their own scratch mazes
+    m_Back.clear();
+
+    // region boundaries, every region at least 2x2
+    const int rx = std::max(1, cols / regionSize);
+    const int ry = std::max(1, rows / regionSize);
+    auto edgeX = [&](int i) { return int(int64_t(cols) * i / rx); };
+    auto edgeY = [&](int j) { return int(int64_t(rows) * j / ry); };
+    const size_t regions = size_t(rx) * size_t(ry);
+
+    auto carve = [&](size_t r) {
+        const int i = int(r % size_t(rx)), j = int(r / size_t(rx));
+        const int x0 = edgeX(i), x1 = edgeX(i + 1);
+        const int y0 = edgeY(j), y1 = edgeY(j + 1);
+
+        thread_local PackedMaze local;
+        local.Generate(x1 - x0, y1 - y0, RegionSeed(base, r));
+
+        // Copy the carved bits in. Neighbouring regions share words, so
+        // every word gets one atomic AND with the bits this region cleared.
+        for (int y = y0; y < y1; ++y) {
+            size_t word = ~size_t(0);
+            uint64_t clear = 0;
+            for (int x = x0; x < x1; ++x) {
+                const size_t cell = size_t(y) * size_t(cols) + size_t(x);
+                if ((cell >> 5) != word) {
+                    if (clear) std::atomic_ref<uint64_t>(m_Walls[word]).fetch_and(~clear, std::memory_order_relaxed);
+                    word = cell >> 5;
+                    clear = 0;
+                }
+                const int sh = int(cell & 31) * 2;
+                if (!local.HasWall(x - x0, y - y0, N)) clear |= uint64_t(1) << sh;
+                if (!local.HasWall(x - x0, y - y0, E)) clear |= uint64_t(2) << sh;
+            }
+            if (clear) std::atomic_ref<uint64_t>(m_Walls[word]).fetch_and(~clear, std::memory_order_relaxed);
+        }
+    };
+
+    if (jobs && jobs->WorkerCount() > 0) {
+        jobs->ParallelFor(regions, 1, [&](size_t b, size_t e) {
+            for (size_t r = b; r < e; ++r) carve(r);
+        });
+    } else {
+        for (size_t r = 0; r < regions; ++r) carve(r);
+    }
+
+    // Stitch: random spanning tree over the region grid (Kruskal). Opening
+    // every adjacent pair would add loops once there are 2x2 regions.
+    struct Edge { int a, b; bool east; };
+    std::vector<Edge> edges;
+    edges.reserve(regions * 2);
+    for (int j = 0; j < ry; ++j) {
+        for (int i = 0; i < rx; ++i) {
+            const int a = j * rx + i;
+            if (i + 1 < rx) edges.push_back({ a, a + 1,  true  });
+            if (j + 1 < ry) edges.push_back({ a, a + rx, false });
+        }
+    }
+    std::shuffle(edges.begin(), edges.end(), rng);
+
+    std::vector<int> parent(regions);
+    std::iota(parent.begin(), parent.end(), 0);
+    auto find = [&](int v) {
+        while (parent[v] != v) { parent[v] = parent[parent[v]]; v = parent[v]; }
+        return v;
+    };
+
+    for (const Edge& e : edges) {
+        const int ra = find(e.a), rb = find(e.b);
+        if (ra == rb) continue;
+        parent[ra] = rb;
+
+        const int i = e.a % rx, j = e.a / rx;
+        if (e.east) {
+            // door in the shared vertical border
+            std::uniform_int_distribution<int> at(edgeY(j), edgeY(j + 1) - 1);
+            ClearWallBit(size_t(at(rng)) * size_t(cols) + size_t(edgeX(i + 1) - 1), 1);
+        } else {
+            std::uniform_int_distribution<int> at(edgeX(i), edgeX(i + 1) - 1);
+            ClearWallBit(size_t(edgeY(j + 1) - 1) * size_t(cols) + size_t(at(rng)), 0);
+        }
+    }
+
+    std::uniform_int_distribution<int> distX(0, cols - 1);
+    std::uniform_int_distribution<int> distY(0, rows - 1);
+    do {
+        m_EndX = distX(rng);
+        m_EndY = distY(rng);
+    } while (m_EndX == 0 && m_EndY == 0);
+}
+
+size_t PackedMaze::CountPassages() const
+{
+    size_t open = 0;
+    for (int y = 0; y < m_Rows; ++y) {
+        for (int x = 0; x < m_Cols; ++x) {
+            if (y + 1 < m_Rows && !HasWall(x, y, N)) ++open;
+            if (x + 1 < m_Cols && !HasWall(x, y, E)) ++open;
+        }
+    }
+    return open;
+}
+
+size_t PackedMaze::CountReachable() const
+{
+    const size_t cells = CellCount();
+    if (cells == 0) return 0;
+
+    std::vector<uint64_t> seen((cells + 63) / 64, 0);
+    auto mark = [&](size_t c) {
+        const uint64_t bit = uint64_t(1) << (c & 63);
+        const bool fresh = !(seen[c >> 6] & bit);
+        seen[c >> 6] |= bit;
+        return fresh;
+    };
+    auto open = [&](int x, int y, int d) {
+        switch (d) {
+            case N: return y + 1 < m_Rows && !HasWall(x, y, N);
+            case E: return x + 1 < m_Cols && !HasWall(x, y, E);
+            case S: return y > 0          && !HasWall(x, y, S);
+            default: return x > 0         && !HasWall(x, y, W);
+        }
+    };
+
+    static const int kDx[4] = { 0, 1, 0, -1 };
+    static const int kDy[4] = { 1, 0, -1, 0 };
+
+    size_t reached = 1;
+    mark(0);
+
+    // first move out of (0,0); none means a single isolated cell
+    int firstD = -1;
+    for (int k = 0; k < 4 && firstD < 0; ++k) if (open(0, 0, k)) firstD = k;
+    if (firstD < 0) return reached;
+
+    // Left hand on the wall: after each move try left, straight, right,
+    // back. (cell, outgoing direction) runs through a cycle, so the tour is
+    // over once (0,0) is about to repeat its first move.
+    int x = 0, y = 0, d = firstD;
+    const size_t limit = 4 * cells + 4;
+    for (size_t step = 0; step < limit; ++step) {
+        x += kDx[d]; y += kDy[d];
+        if (mark(size_t(y) * size_t(m_Cols) + size_t(x))) ++reached;
+
+        for (int turn : { 3, 0, 1, 2 }) {
+            if (open(x, y, (d + turn) & 3)) { d = (d + turn) & 3; break; }
+        }
+        if (x == 0 && y == 0 && d == firstD) break;
+    }
+    return reached;
+}
+
+bool PackedMaze::IsPerfect() const
+{
+    // cells-1 passages and connected <=> spanning tree
+    const size_t cells = CellCount();
+    return cells > 0 && CountPassages() == cells - 1 && CountReachable() == cells;
+}
+
+} // namespace gameplay
@@ -0,0 +1,83 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace gameplay {
+
+    class JobSystem;
+
+    // Perfect maze carved with the same DFS backtracker as MazeGenerator,
+    // stored as bits so very large grids stay small: two wall bits per cell
+    // (north, east) plus a visited bitmap. South/west walls are read from the
+    // neighbour; the outer south/west border is implicit, with the start cell
+    // (0,0) open to the south.
+    //
+    // All buffers are sized once per grid size and reused, so carving
+    // allocates nothing after the first call at a given size.
+    class PackedMaze {
+    public:
+        // directions, same order as MazeGenerator: N=0, E=1, S=2, W=3
+        enum Dir : int { N = 0, E = 1, S = 2, W = 3 };
+
+        void Generate(int cols, int rows, uint32_t seed = 0);
+
+        // Splits the grid into regions of about regionSize x regionSize cells,
+        // carves each one as its own perfect maze (own seeded mt19937) in
+        // parallel, then joins them along a seeded spanning tree over the
+        // region grid, one passage per tree edge, so the result is still a
+        // perfect maze. Runs serially without a job system.
+        void GenerateParallel(int cols, int rows, uint32_t seed,
+                              int regionSize, JobSystem* jobs);
+
+        // Loads a maze carved elsewhere from per-cell wall bits (row-major,
+        // N=1 E=2 S=4 W=8 like Maze::cellWalls) so the checks below can run
+        // on it. Only the N/E bits are kept.
+        void Assign(int cols, int rows, const uint8_t* cellWalls);
+
+        int Cols() const { return m_Cols; }
+        int Rows() const { return m_Rows; }
+        int EndX() const { return m_EndX; }
+        int EndY() const { return m_EndY; }
+
+        bool HasWall(int x, int y, int dir) const;
+
+        // bytes held by the wall bits, visited bitmap and DFS stack
+        size_t MemoryBytes() const;
+
+        // passages between neighbouring cells (cells - 1 for a perfect maze)
+        size_t CountPassages() const;
+
+        // Cells reached by a left-hand wall-following tour from (0,0). On a
+        // tree the tour walks every edge twice and sees the whole component,
+        // needing only a bitmap.
+        size_t CountReachable() const;
+
+        // every cell reachable and no loops
+        bool IsPerfect() const;
+
+    private:
+        size_t CellCount() const { return size_t(m_Cols) * size_t(m_Rows); }
+
+        bool WallBit(size_t cell, int bit) const {
+            return (m_Walls[cell >> 5] >> ((cell & 31) * 2 + bit)) & 1u;
+        }
+        void ClearWallBit(size_t cell, int bit) {
+            m_Walls[cell >> 5] &= ~(uint64_t(1) << ((cell & 31) * 2 + bit));
+        }
+        bool Visited(size_t cell) const {
+            return (m_Visited[cell >> 6] >> (cell & 63)) & 1u;
+        }
+        void MarkVisited(size_t cell) {
+            m_Visited[cell >> 6] |= uint64_t(1) << (cell & 63);
+        }
+
+        int m_Cols{0}, m_Rows{0};
+        int m_EndX{0}, m_EndY{0};
+
+        std::vector<uint64_t> m_Walls;     // 32 cells per word, bit0 = N, bit1 = E
+        std::vector<uint64_t> m_Visited;   // 64 cells per word
+        std::vector<uint8_t>  m_Back;      // DFS stack, 2-bit direction back to the parent
+    };
+
+} // namespace gameplay
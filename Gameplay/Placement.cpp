@@ -0,0 +1,95 @@
+#include "Gameplay/Placement.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace gameplay {
+
+bool Placement::Scatter(std::mt19937& rng, const Maze& maze, const Request& req,
+                        std::vector<ThreeBlade>& out)
+{
+    out.clear();
+    if (maze.cols <= 0 || maze.rows <= 0 || req.count <= 0) return req.count <= 0;
+
+    const float inset = req.radius + req.pad;
+    float fx0, fy0, fx1, fy1;
+    if (!maze.CellInterior(0, 0, inset, fx0, fy0, fx1, fy1)) return false;   // cells too small
+
+    // background grid over the maze, cell = spacing/sqrt2 -> one point max
+    const float spacing = std::max(req.spacing, 1e-3f);
+    const float bg      = spacing / std::sqrt(2.f);
+    const float invBg   = 1.f / bg;
+    const float ox = maze.originX, oy = maze.originY;
+    const int gw = std::max(1, int(std::ceil(maze.cols * maze.cellW * invBg)) + 1);
+    const int gh = std::max(1, int(std::ceil(maze.rows * maze.cellH * invBg)) + 1);
+    // kept per thread so level builds don't reallocate it every time
+    thread_local std::vector<int32_t> cellPoint;
+    cellPoint.assign(size_t(gw) * size_t(gh), -1);
+
+    auto bgCell = [&](float x, float y, int& gx, int& gy) {
+        gx = std::clamp(int((x - ox) * invBg), 0, gw - 1);
+        gy = std::clamp(int((y - oy) * invBg), 0, gh - 1);
+    };
+
+    auto farFromOthers = [&](float x, float y) {
+        int gx, gy; bgCell(x, y, gx, gy);
+        const float s2 = spacing * spacing;
+        for (int j = std::max(0, gy - 2); j <= std::min(gh - 1, gy + 2); ++j) {
+            for (int i = std::max(0, gx - 2); i <= std::min(gw - 1, gx + 2); ++i) {
+                const int32_t k = cellPoint[size_t(j) * size_t(gw) + size_t(i)];
+                if (k < 0) continue;
+                const float dx = out[size_t(k)][0] - x, dy = out[size_t(k)][1] - y;
+                if (dx*dx + dy*dy < s2) return false;
+            }
+        }
+        return true;
+    };
+
+    auto clearOfAvoid = [&](float x, float y) {
+        for (const auto& [C, minD] : req.avoid) {
+            const float dx = C[0] - x, dy = C[1] - y;
+            if (dx*dx + dy*dy < minD * minD) return false;
+        }
+        return true;
+    };
+
+    std::uniform_int_distribution<int> pickX(0, maze.cols - 1);
+    std::uniform_int_distribution<int> pickY(0, maze.rows - 1);
+    std::uniform_real_distribution<float> unit(0.f, 1.f);
+
+    // uniform over the free interiors (all cells are the same size)
+    auto sample = [&](float& x, float& y) {
+        float x0, y0, x1, y1;
+        maze.CellInterior(pickX(rng), pickY(rng), inset, x0, y0, x1, y1);
+        x = x0 + unit(rng) * (x1 - x0);
+        y = y0 + unit(rng) * (y1 - y0);
+    };
+
+    out.reserve(size_t(req.count));
+    const int tries = std::max(1, req.triesPerPoint);
+
+    for (int n = 0; n < req.count; ++n) {
+        float x = 0.f, y = 0.f;
+        bool ok = false;
+        for (int t = 0; t < tries && !ok; ++t) {
+            sample(x, y);
+            ok = clearOfAvoid(x, y) && farFromOthers(x, y);
+        }
+        if (!ok) {
+            // crowded: keep it wall-free and away from the avoid set
+            for (int t = 0; t < tries && !ok; ++t) {
+                sample(x, y);
+                ok = clearOfAvoid(x, y);
+            }
+        }
+        if (!ok) continue;   // nowhere clear of the avoid set: come up short
+
+        int gx, gy; bgCell(x, y, gx, gy);
+        int32_t& slot = cellPoint[size_t(gy) * size_t(gw) + size_t(gx)];
+        if (slot < 0) slot = int32_t(out.size());
+        out.emplace_back(x, y, 0.f);
+    }
+    return true;
+}
+
+} // namespace gameplay
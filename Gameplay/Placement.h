@@ -0,0 +1,38 @@
+#pragma once
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "../FlyFish.h"
+#include "Gameplay/Maze.h"
+
+namespace gameplay {
+
+    // Scatters circles inside a maze without wall tests: candidates are drawn
+    // straight from the free interiors of the maze cells, and spacing is
+    // enforced Poisson-disk style through a background grid whose cells fit
+    // at most one point, so each try looks at a fixed 5x5 block of cells and
+    // placing n points is O(n).
+    struct Placement {
+        struct Request {
+            int   count = 0;
+            float radius = 10.f;
+            float spacing = 28.f;   // min centre-to-centre distance
+            float pad = 2.f;        // extra clearance from the walls
+            int   triesPerPoint = 30;
+
+            // circles to keep away from: (centre, min distance to it)
+            std::vector<std::pair<ThreeBlade, float>> avoid;
+        };
+
+        // Appends up to req.count points to 'out' (cleared first). When the
+        // maze runs out of room for the spacing, the rest are still placed in
+        // free cell interiors, just without the spacing guarantee; a point
+        // that can't get clear of the avoid set is dropped, so out.size()
+        // can come up short. Needs a cell layout (maze.cols > 0); returns
+        // false and places nothing otherwise.
+        static bool Scatter(std::mt19937& rng, const Maze& maze, const Request& req,
+                            std::vector<ThreeBlade>& out);
+    };
+
+} // namespace gameplay
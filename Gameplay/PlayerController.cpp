@@ -3,6 +3,7 @@
 #include <cmath>
 #include "Gameplay/PlayerController.h"
 #include "Gameplay/GeoMotors.h"
+#include "Gameplay/GravityField.h"
 
 namespace gameplay {
     void PlayerController::StepKinematics(
@@ -10,7 +11,8 @@ namespace gameplay {
         float &vx, float &vy, float &vzEnergy,
         const InputState &in,
         const std::vector<ThreeBlade> &pillars,
-        const std::vector<int> &activeSet, float dt, const Tuning &k) {
+        const std::vector<int> &activeSet, float dt, const Tuning &k,
+        const GravityField *baked) {
         // accumulate acceleration (ideal components in world axes)
         float ax = 0.f, ay = 0.f;
 
@@ -23,9 +25,17 @@ namespace gameplay {
 
         // gravity from all pillars using join and line norm
         {
-            const float kGravAccel = 220.f;
-            const float kGravMinR = 30.f;
-            for (const ThreeBlade &C: pillars) {
+            size_t first = 0;
+            float gax = 0.f, gay = 0.f;
+            if (baked && baked->PillarCount() <= (int) pillars.size() &&
+                baked->Sample(X[0], X[1], gax, gay)) {
+                ax += gax;
+                ay += gay;
+                first = size_t(baked->PillarCount());
+            }
+
+            for (size_t i = first; i < pillars.size(); ++i) {
+                const ThreeBlade &C = pillars[i];
                 // line L = X join C (direction = C - X in [3],[4],[5])
                 TwoBlade L = X & C;
                 float R = L.Norm();
@@ -35,7 +45,7 @@ namespace gameplay {
                 const float rx = L[3] / R;
                 const float ry = L[4] / R;
 
-                const float g = kGravAccel / std::max(R, kGravMinR);
+                const float g = k.gravAccel / std::max(R, k.gravMinR);
                 ax += g * rx;
                 ay += g * ry;
             }
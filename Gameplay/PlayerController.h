@@ -4,6 +4,8 @@
 
 namespace gameplay {
 
+    class GravityField;
+
     struct InputState {
         bool up{false}, down{false}, left{false}, right{false}, boost{false};
     };
@@ -22,16 +24,22 @@ namespace gameplay {
             float minSpinR     = 60.f;
             float slingFactor  = 0.01f;
             float maxEnergy    = 100000.f;
+            float gravAccel    = 220.f;
+            float gravMinR     = 30.f;
         };
 
 
+        // When 'baked' is given, the first baked->PillarCount() entries of
+        // 'pillars' are the static pillars already baked into the field;
+        // their gravity is sampled from it instead of summed per pillar.
         static void StepKinematics(
             ThreeBlade& X,
             float& vx, float& vy, float& vzEnergy,
             const InputState& in,
             const std::vector<ThreeBlade>& pillars,
             const std::vector<int>& activeSet,
-            float dt, const Tuning& k);
+            float dt, const Tuning& k,
+            const GravityField* baked = nullptr);
     };
 
 } // namespace gameplay
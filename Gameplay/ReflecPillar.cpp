@@ -12,11 +12,15 @@ bool gameplay::ReflectPillar::TryReflect(ThreeBlade &X, float &vx, float &vy, fl
 
     bool reflected = false;
     if (inside && !wasInside) {
-        Motor Rm = GeoMotors::MakeRotationAboutPoint(C, 3.14159265358979323846f);
-        X = GeoMotors::Apply(X, Rm);
-        vx = -vx; vy = -vy;
+        Reflect(X, vx, vy);
         reflected = true;
     }
     wasInside = inside;
     return reflected;
 }
+
+void gameplay::ReflectPillar::Reflect(ThreeBlade &X, float &vx, float &vy) const {
+    Motor Rm = GeoMotors::MakeRotationAboutPoint(C, 3.14159265358979323846f);
+    X = GeoMotors::Apply(X, Rm);
+    vx = -vx; vy = -vy;
+}
@@ -21,6 +21,10 @@ namespace gameplay {
         // returns true if we performed a reflection this frame
         bool TryReflect(ThreeBlade& X, float& vx, float& vy, float /*dt*/);
 
+        // the half-turn about C itself, for callers that track entering
+        // on their own (TriggerSystem)
+        void Reflect(ThreeBlade& X, float& vx, float& vy) const;
+
         const ThreeBlade& Center() const { return C; }
     };
 
@@ -0,0 +1,16 @@
+#pragma once
+#include <cstdint>
+
+namespace gameplay {
+
+    // SplitMix64 finaliser: turns (seed, index) style keys into well spread
+    // seeds, so tiles, rows and regions get independent RNG streams.
+    inline uint64_t SplitMix64(uint64_t x)
+    {
+        x += 0x9E3779B97F4A7C15ull;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+        return x ^ (x >> 31);
+    }
+
+} // namespace gameplay
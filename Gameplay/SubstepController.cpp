@@ -0,0 +1,29 @@
+#include "Gameplay/SubstepController.h"
+#include <algorithm>
+#include <cmath>
+
+namespace gameplay {
+
+int SubstepController::Choose(float speed, float dt, float wallThickness, float clearance)
+{
+    const int cap = std::max(1, settings.maxSubsteps);
+    const float travel = std::fabs(speed) * std::max(dt, 0.f);
+
+    int n = 1;
+    bool capped = false;
+    if (travel * settings.calmMargin > clearance) {
+        const float perStep = std::max(1.f, settings.travelPerWall * wallThickness);
+        const float want = std::ceil(travel / perStep);
+        capped = want > float(cap);
+        n = capped ? cap : std::max(1, int(want));
+    }
+
+    m_Stats.frames++;
+    m_Stats.substeps += size_t(n);
+    m_Stats.capped += capped ? 1 : 0;
+    m_Stats.maxUsed = std::max(m_Stats.maxUsed, n);
+    m_Stats.histogram[size_t(std::min(n, Stats::kBuckets) - 1)]++;
+    return n;
+}
+
+} // namespace gameplay
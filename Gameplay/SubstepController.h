@@ -0,0 +1,44 @@
+#pragma once
+#include <array>
+#include <cstddef>
+
+namespace gameplay {
+
+    // Decides how many substeps one frame of a body is split into. A frame
+    // whose move cannot reach anything (clearance well above the distance
+    // travelled) takes one step; otherwise the move is cut so no substep
+    // covers more than a fraction of a wall's thickness, up to a hard cap.
+    class SubstepController {
+    public:
+        struct Settings {
+            int   maxSubsteps   = 8;      // budget per frame
+            float travelPerWall = 0.5f;   // max move per substep, in wall thicknesses
+            float calmMargin    = 2.f;    // calm while travel * calmMargin <= clearance
+        };
+
+        struct Stats {
+            static constexpr int kBuckets = 9;   // frames by substep count, last = 8+
+
+            size_t frames = 0;
+            size_t substeps = 0;
+            size_t capped = 0;       // frames that wanted more than maxSubsteps
+            int    maxUsed = 0;
+            std::array<size_t, kBuckets> histogram{};
+
+            double Average() const { return frames ? double(substeps) / double(frames) : 0.0; }
+        };
+
+        Settings settings;
+
+        // speed in units/s; clearance is the free distance to the nearest
+        // obstacle (0 when unknown, which never counts as calm)
+        int Choose(float speed, float dt, float wallThickness, float clearance);
+
+        const Stats& GetStats() const { return m_Stats; }
+        void ResetStats() { m_Stats = {}; }
+
+    private:
+        Stats m_Stats;
+    };
+
+} // namespace gameplay
@@ -0,0 +1,195 @@
+#include "Gameplay/TriggerSystem.h"
+#include <algorithm>
+#include <cmath>
+
+namespace gameplay {
+
+// Per-thread "seen this query" marks, so a trigger listed under several
+// cells (or sharing a bucket with another cell) is tested once.
+struct TriggerMarks {
+    std::vector<uint32_t> stamp;
+    uint32_t current = 0;
+
+    void Begin(size_t triggers) {
+        if (stamp.size() < triggers) stamp.resize(triggers, 0);
+        if (++current == 0) { std::fill(stamp.begin(), stamp.end(), 0u); current = 1; }
+    }
+    bool First(uint32_t t) {
+        if (stamp[t] == current) return false;
+        stamp[t] = current;
+        return true;
+    }
+};
+
+TriggerSystem::TriggerSystem(float cellSize)
+    : m_CellSize(std::max(cellSize, 1.f))
+{
+}
+
+void TriggerSystem::Clear()
+{
+    m_Triggers.clear();
+    m_BucketStart.clear();
+    m_Entries.clear();
+    m_Dirty = true;
+    m_Prev.clear();
+    m_Curr.clear();
+    m_Events.clear();
+}
+
+void TriggerSystem::SetCellSize(float cellSize)
+{
+    m_CellSize = std::max(cellSize, 1.f);
+    m_Dirty = true;
+}
+
+uint32_t TriggerSystem::AddCircle(float cx, float cy, float r, uint32_t tag, uint8_t flags)
+{
+    r = std::max(r, 1e-6f);
+    m_Triggers.push_back(Trigger{ cx - r, cy - r, cx + r, cy + r, cx, cy, r, tag, flags, true });
+    m_Dirty = true;
+    return uint32_t(m_Triggers.size() - 1);
+}
+
+uint32_t TriggerSystem::AddBox(float minX, float minY, float maxX, float maxY,
+                               uint32_t tag, uint8_t flags)
+{
+    if (minX > maxX) std::swap(minX, maxX);
+    if (minY > maxY) std::swap(minY, maxY);
+    m_Triggers.push_back(Trigger{ minX, minY, maxX, maxY, 0.f, 0.f, 0.f, tag, flags, true });
+    m_Dirty = true;
+    return uint32_t(m_Triggers.size() - 1);
+}
+
+void TriggerSystem::MoveCircle(uint32_t id, float cx, float cy)
+{
+    Trigger& t = m_Triggers[id];
+    if (t.r <= 0.f) return;
+    t.cx = cx; t.cy = cy;
+    t.minX = cx - t.r; t.minY = cy - t.r;
+    t.maxX = cx + t.r; t.maxY = cy + t.r;
+    m_Dirty = true;
+}
+
+void TriggerSystem::SetEnabled(uint32_t id, bool enabled)
+{
+    m_Triggers[id].enabled = enabled;   // stays hashed, skipped by the tests
+}
+
+int32_t TriggerSystem::CellOf(float v) const
+{
+    return int32_t(std::floor(v / m_CellSize));
+}
+
+size_t TriggerSystem::Bucket(int32_t cx, int32_t cy) const
+{
+    const uint32_t h = (uint32_t(cx) * 73856093u) ^ (uint32_t(cy) * 19349663u);
+    return size_t(h) & (m_BucketStart.size() - 2);   // table size is a power of two
+}
+
+bool TriggerSystem::Touches(const Trigger& t, float x, float y, float radius)
+{
+    const float rr = (t.flags & kPoint) ? 0.f : radius;
+    if (t.r > 0.f) {
+        const float dx = x - t.cx, dy = y - t.cy;
+        const float reach = t.r + rr;
+        return dx*dx + dy*dy <= reach * reach;
+    }
+    const float dx = x - std::clamp(x, t.minX, t.maxX);
+    const float dy = y - std::clamp(y, t.minY, t.maxY);
+    return dx*dx + dy*dy <= rr * rr;
+}
+
+void TriggerSystem::Rehash()
+{
+    m_Dirty = false;
+
+    size_t entries = 0;
+    for (const Trigger& t : m_Triggers)
+        entries += size_t(CellOf(t.maxX) - CellOf(t.minX) + 1) * size_t(CellOf(t.maxY) - CellOf(t.minY) + 1);
+
+    size_t buckets = 16;
+    while (buckets < entries) buckets <<= 1;
+    m_BucketStart.assign(buckets + 1, 0);
+
+    auto forCells = [this](const Trigger& t, auto&& fn) {
+        const int32_t x0 = CellOf(t.minX), x1 = CellOf(t.maxX);
+        const int32_t y0 = CellOf(t.minY), y1 = CellOf(t.maxY);
+        for (int32_t cy = y0; cy <= y1; ++cy)
+            for (int32_t cx = x0; cx <= x1; ++cx) fn(Bucket(cx, cy));
+    };
+
+    for (const Trigger& t : m_Triggers)
+        forCells(t, [&](size_t b) { ++m_BucketStart[b + 1]; });
+    for (size_t b = 0; b < buckets; ++b) m_BucketStart[b + 1] += m_BucketStart[b];
+
+    m_Entries.resize(entries);
+    std::vector<uint32_t> fill(m_BucketStart.begin(), m_BucketStart.end() - 1);
+    for (uint32_t id = 0; id < uint32_t(m_Triggers.size()); ++id)
+        forCells(m_Triggers[id], [&](size_t b) { m_Entries[fill[b]++] = id; });
+}
+
+void TriggerSystem::Touching(float x, float y, float radius, std::vector<uint32_t>& out) const
+{
+    out.clear();
+    if (m_Dirty || m_BucketStart.empty()) {
+        for (uint32_t id = 0; id < uint32_t(m_Triggers.size()); ++id)
+            if (m_Triggers[id].enabled && Touches(m_Triggers[id], x, y, radius)) out.push_back(id);
+        return;
+    }
+
+    thread_local TriggerMarks s_Marks;
+    s_Marks.Begin(m_Triggers.size());
+
+    const int32_t x0 = CellOf(x - radius), x1 = CellOf(x + radius);
+    const int32_t y0 = CellOf(y - radius), y1 = CellOf(y + radius);
+    for (int32_t cy = y0; cy <= y1; ++cy) {
+        for (int32_t cx = x0; cx <= x1; ++cx) {
+            const size_t b = Bucket(cx, cy);
+            for (uint32_t k = m_BucketStart[b]; k < m_BucketStart[b + 1]; ++k) {
+                const uint32_t id = m_Entries[k];
+                if (!s_Marks.First(id)) continue;
+                const Trigger& t = m_Triggers[id];
+                if (t.enabled && Touches(t, x, y, radius)) out.push_back(id);
+            }
+        }
+    }
+    std::sort(out.begin(), out.end());
+}
+
+void TriggerSystem::Update(const float* x, const float* y, float radius, size_t bodies)
+{
+    if (m_Dirty) Rehash();
+
+    thread_local std::vector<uint32_t> s_Touch;
+    m_Curr.clear();
+    for (size_t i = 0; i < bodies; ++i) {
+        Touching(x[i], y[i], radius, s_Touch);
+        for (uint32_t id : s_Touch) m_Curr.push_back((uint64_t(i) << 32) | id);
+    }
+
+    // both sorted: walk them together
+    m_Events.clear();
+    size_t a = 0, b = 0;
+    while (a < m_Prev.size() || b < m_Curr.size()) {
+        uint64_t key;
+        TriggerEvent::Kind kind;
+        if (b == m_Curr.size() || (a < m_Prev.size() && m_Prev[a] < m_Curr[b])) {
+            key = m_Prev[a++]; kind = TriggerEvent::Exit;
+        } else if (a == m_Prev.size() || m_Curr[b] < m_Prev[a]) {
+            key = m_Curr[b++]; kind = TriggerEvent::Enter;
+        } else {
+            key = m_Curr[b++]; ++a; kind = TriggerEvent::Stay;
+        }
+        m_Events.push_back(TriggerEvent{ uint32_t(key >> 32), uint32_t(key), kind });
+    }
+    m_Prev.swap(m_Curr);
+}
+
+void TriggerSystem::Update(const ThreeBlade& X, float radius)
+{
+    const float x = X[0], y = X[1];
+    Update(&x, &y, radius, 1);
+}
+
+} // namespace gameplay
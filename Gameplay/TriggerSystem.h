@@ -0,0 +1,88 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "../FlyFish.h"
+
+namespace gameplay {
+
+    struct TriggerEvent {
+        enum Kind : uint8_t { Enter, Stay, Exit };
+
+        uint32_t body;
+        uint32_t trigger;
+        Kind     kind;
+    };
+
+    // Circle and box trigger volumes in a spatial hash, with per-body
+    // enter/stay/exit tracking.
+    //
+    // Triggers are hashed by the grid cells their bounds cover (CSR buckets,
+    // rebuilt lazily after triggers were added or moved). Each Update takes
+    // the current bodies, looks up only the buckets under each body and
+    // diffs the touching (body, trigger) pairs against the previous Update,
+    // so the cost follows the pairs that are actually near each other, not
+    // bodies x triggers. Bodies are identified by their index in Update;
+    // a trigger that gets disabled reports Exit for whoever was inside.
+    class TriggerSystem {
+    public:
+        enum Flags : uint8_t {
+            kPoint = 1,   // fires on the body's centre, not on any overlap
+        };
+
+        explicit TriggerSystem(float cellSize = 64.f);
+
+        // drops triggers, bodies and the previous frame's contacts
+        void Clear();
+        void SetCellSize(float cellSize);
+
+        uint32_t AddCircle(float cx, float cy, float r, uint32_t tag = 0, uint8_t flags = 0);
+        uint32_t AddBox(float minX, float minY, float maxX, float maxY,
+                        uint32_t tag = 0, uint8_t flags = 0);
+
+        void MoveCircle(uint32_t id, float cx, float cy);
+        void SetEnabled(uint32_t id, bool enabled);
+        bool Enabled(uint32_t id) const { return m_Triggers[id].enabled; }
+
+        size_t   Count() const { return m_Triggers.size(); }
+        uint32_t Tag(uint32_t id) const { return m_Triggers[id].tag; }
+
+        // one Update per frame (or per step); events are sorted by body, then trigger
+        void Update(const float* x, const float* y, float radius, size_t bodies);
+        void Update(const ThreeBlade& X, float radius);
+
+        const std::vector<TriggerEvent>& Events() const { return m_Events; }
+
+        // enabled triggers the circle touches right now, ascending. Changes
+        // no state, so several threads may query at once; between adding or
+        // moving triggers and the next Update it scans every trigger.
+        void Touching(float x, float y, float radius, std::vector<uint32_t>& out) const;
+
+    private:
+        struct Trigger {
+            float    minX, minY, maxX, maxY;   // bounds, hashed
+            float    cx, cy, r;                // circles: r > 0
+            uint32_t tag;
+            uint8_t  flags;
+            bool     enabled;
+        };
+
+        static bool Touches(const Trigger& t, float x, float y, float radius);
+        void Rehash();
+        size_t Bucket(int32_t cx, int32_t cy) const;
+        int32_t CellOf(float v) const;
+
+        std::vector<Trigger> m_Triggers;
+        float m_CellSize;
+
+        // spatial hash, CSR over a power-of-two bucket table
+        std::vector<uint32_t> m_BucketStart;
+        std::vector<uint32_t> m_Entries;
+        bool m_Dirty = true;
+
+        std::vector<uint64_t> m_Prev, m_Curr;   // (body << 32 | trigger), sorted
+        std::vector<TriggerEvent> m_Events;
+    };
+
+} // namespace gameplay
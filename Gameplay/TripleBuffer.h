@@ -0,0 +1,44 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+namespace gameplay {
+
+    // Lock-free single-producer / single-consumer handoff of whole frames.
+    // The producer always has a private slot to fill, the consumer always has
+    // a private slot to read, and the third slot is swapped between them with
+    // one atomic exchange. Neither side ever waits for the other.
+    template <typename T>
+    class TripleBuffer {
+    public:
+        // producer side
+        T& WriteSlot() { return m_Slots[m_Write]; }
+
+        void Publish()
+        {
+            const uint8_t prev = m_Middle.exchange(uint8_t(m_Write | kFresh), std::memory_order_acq_rel);
+            m_Write = uint8_t(prev & kIndexMask);
+        }
+
+        // consumer side; returns false when nothing new was published
+        bool Acquire()
+        {
+            if ((m_Middle.load(std::memory_order_acquire) & kFresh) == 0) return false;
+            const uint8_t prev = m_Middle.exchange(m_Read, std::memory_order_acq_rel);
+            m_Read = uint8_t(prev & kIndexMask);
+            return true;
+        }
+
+        const T& ReadSlot() const { return m_Slots[m_Read]; }
+
+    private:
+        static constexpr uint8_t kIndexMask = 0x3;
+        static constexpr uint8_t kFresh     = 0x4;
+
+        T m_Slots[3]{};
+        uint8_t m_Write{0};
+        uint8_t m_Read{2};
+        std::atomic<uint8_t> m_Middle{1};
+    };
+
+} // namespace gameplay
@@ -0,0 +1,107 @@
+#include "Gameplay/WallGrid.h"
+#include <algorithm>
+#include <cmath>
+
+#include "Gameplay/Maze.h"
+
+namespace gameplay {
+
+void WallGrid::Clear()
+{
+    cols = rows = 0;
+    cellStart.clear();
+    indices.clear();
+}
+
+int WallGrid::CellX(float x) const
+{
+    const int c = int(std::floor((x - originX) / cellW));
+    return std::clamp(c, 0, cols - 1);
+}
+
+int WallGrid::CellY(float y) const
+{
+    const int r = int(std::floor((y - originY) / cellH));
+    return std::clamp(r, 0, rows - 1);
+}
+
+void WallGrid::Build(const std::vector<MazeWall>& walls,
+                     float ox, float oy, float cw, float ch,
+                     int c, int r)
+{
+    Clear();
+    if (c <= 0 || r <= 0 || cw <= 0.f || ch <= 0.f) return;
+
+    originX = ox; originY = oy;
+    cellW = cw;   cellH = ch;
+    cols = c;     rows = r;
+
+    const size_t cells = size_t(cols) * size_t(rows);
+
+    // pass 1: count walls per cell, pass 2: scatter indices
+    std::vector<uint32_t> counts(cells + 1, 0);
+    for (const auto& w : walls) {
+        const int x0 = CellX(w.x), x1 = CellX(w.x + w.w);
+        const int y0 = CellY(w.y), y1 = CellY(w.y + w.h);
+        for (int y = y0; y <= y1; ++y)
+            for (int x = x0; x <= x1; ++x)
+                counts[size_t(y) * cols + x]++;
+    }
+
+    cellStart.assign(cells + 1, 0);
+    for (size_t i = 0; i < cells; ++i) cellStart[i + 1] = cellStart[i] + counts[i];
+    indices.resize(cellStart[cells]);
+
+    std::fill(counts.begin(), counts.end(), 0);
+    for (uint32_t i = 0; i < uint32_t(walls.size()); ++i) {
+        const auto& w = walls[i];
+        const int x0 = CellX(w.x), x1 = CellX(w.x + w.w);
+        const int y0 = CellY(w.y), y1 = CellY(w.y + w.h);
+        for (int y = y0; y <= y1; ++y) {
+            for (int x = x0; x <= x1; ++x) {
+                const size_t cell = size_t(y) * cols + x;
+                indices[cellStart[cell] + counts[cell]++] = i;
+            }
+        }
+    }
+}
+
+void WallGrid::BuildUniform(const std::vector<MazeWall>& walls, float cellSize)
+{
+    if (walls.empty() || cellSize <= 0.f) { Clear(); return; }
+
+    float minX = walls[0].x, minY = walls[0].y;
+    float maxX = walls[0].x + walls[0].w, maxY = walls[0].y + walls[0].h;
+    for (const auto& w : walls) {
+        minX = std::min(minX, w.x);       minY = std::min(minY, w.y);
+        maxX = std::max(maxX, w.x + w.w); maxY = std::max(maxY, w.y + w.h);
+    }
+
+    const int c = std::max(1, int(std::ceil((maxX - minX) / cellSize)));
+    const int r = std::max(1, int(std::ceil((maxY - minY) / cellSize)));
+    Build(walls, minX, minY, cellSize, cellSize, c, r);
+}
+
+void WallGrid::Query(float minX, float minY, float maxX, float maxY,
+                     std::vector<uint32_t>& out) const
+{
+    out.clear();
+    if (Empty()) return;
+
+    const int x0 = CellX(minX), x1 = CellX(maxX);
+    const int y0 = CellY(minY), y1 = CellY(maxY);
+    for (int y = y0; y <= y1; ++y) {
+        for (int x = x0; x <= x1; ++x) {
+            const size_t cell = size_t(y) * cols + x;
+            out.insert(out.end(), indices.begin() + cellStart[cell], indices.begin() + cellStart[cell + 1]);
+        }
+    }
+
+    // walls spanning several cells show up more than once
+    if (x1 > x0 || y1 > y0) {
+        std::sort(out.begin(), out.end());
+        out.erase(std::unique(out.begin(), out.end()), out.end());
+    }
+}
+
+} // namespace gameplay
@@ -0,0 +1,41 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+namespace gameplay {
+
+    struct MazeWall;
+
+    // Cell -> wall index table over a regular grid (CSR layout).
+    // Built either on the maze's own cell grid or, for arbitrary wall sets,
+    // on a uniform grid fitted around the walls. A wall is listed in every
+    // cell its rectangle overlaps; coordinates outside the grid clamp to the
+    // border cells, so queries never miss a wall.
+    struct WallGrid {
+        float originX = 0.f, originY = 0.f;
+        float cellW = 1.f, cellH = 1.f;
+        int   cols = 0, rows = 0;
+
+        std::vector<uint32_t> cellStart;   // cols*rows + 1 offsets into 'indices'
+        std::vector<uint32_t> indices;
+
+        bool Empty() const { return cellStart.empty(); }
+        void Clear();
+
+        void Build(const std::vector<MazeWall>& walls,
+                   float originX, float originY,
+                   float cellW, float cellH,
+                   int cols, int rows);
+
+        // uniform hash grid with square cells around the walls' bounds
+        void BuildUniform(const std::vector<MazeWall>& walls, float cellSize);
+
+        // sorted, de-duplicated indices of walls in cells touching the box
+        void Query(float minX, float minY, float maxX, float maxY,
+                   std::vector<uint32_t>& out) const;
+
+        int CellX(float x) const;
+        int CellY(float y) const;
+    };
+
+} // namespace gameplay
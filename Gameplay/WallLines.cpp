@@ -0,0 +1,36 @@
+#include "Gameplay/WallLines.h"
+#include <algorithm>
+#include <cmath>
+
+#include "Gameplay/Maze.h"
+
+namespace gameplay {
+
+// unit line a*x + b*y + c = 0
+static inline OneBlade UnitLine(float a, float b, float c)
+{
+    const float n = std::sqrt(std::max(1e-12f, a*a + b*b));
+    return OneBlade(c / n, a / n, b / n, 0.0f);
+}
+
+void WallLines::Build(const std::vector<MazeWall>& walls)
+{
+    lines.clear();
+    lines.reserve(walls.size() * 4);
+    for (const MazeWall& w : walls) {
+        lines.push_back(UnitLine(+1.f,  0.f, -w.x));           // left
+        lines.push_back(UnitLine(-1.f,  0.f, +(w.x + w.w)));   // right
+        lines.push_back(UnitLine( 0.f, +1.f, -w.y));           // bottom
+        lines.push_back(UnitLine( 0.f, -1.f, +(w.y + w.h)));   // top
+    }
+}
+
+bool WallLines::AnyWithin(const uint32_t* walls, size_t n, const ThreeBlade& X, float r) const
+{
+    const float r2 = r * r;
+    for (size_t i = 0; i < n; ++i)
+        if (DistanceSq(walls[i], X) <= r2) return true;
+    return false;
+}
+
+} // namespace gameplay
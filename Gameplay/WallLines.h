@@ -0,0 +1,43 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "../FlyFish.h"
+
+namespace gameplay {
+
+    struct MazeWall;
+
+    // Unit PGA boundary lines of every wall, four per wall in one contiguous
+    // array (left, right, bottom, top), each oriented so that L & X is the
+    // signed distance of X to that side, positive toward the wall's inside.
+    // Built once with the rest of the maze's lookup data, so the queries
+    // only evaluate joins and never normalise anything.
+    struct WallLines {
+        enum Side { Left = 0, Right = 1, Bottom = 2, Top = 3 };
+
+        std::vector<OneBlade> lines;   // 4 * wall + side
+
+        void Build(const std::vector<MazeWall>& walls);
+        void Clear() { lines.clear(); }
+        bool Empty() const { return lines.empty(); }
+        size_t Count() const { return lines.size() / 4; }
+
+        const OneBlade* Of(uint32_t wall) const { return lines.data() + size_t(wall) * 4; }
+
+        // squared distance from X to wall i (0 inside it): the parts of X
+        // outside the two slabs, straight from the four signed distances
+        float DistanceSq(uint32_t wall, const ThreeBlade& X) const {
+            const OneBlade* L = Of(wall);
+            const float ox = std::max(0.f, -std::min(L[Left] & X, L[Right] & X));
+            const float oy = std::max(0.f, -std::min(L[Bottom] & X, L[Top] & X));
+            return ox * ox + oy * oy;
+        }
+
+        // does the circle (X, r) touch any of the listed walls
+        bool AnyWithin(const uint32_t* walls, size_t n, const ThreeBlade& X, float r) const;
+    };
+
+} // namespace gameplay
@@ -0,0 +1,162 @@
+#include "Gameplay/WallSDF.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#include "Gameplay/Maze.h"
+
+namespace gameplay {
+
+// signed distance from (px,py) to one rectangle and its outward gradient
+static inline float RectSDF(const MazeWall& w, float px, float py, float& gx, float& gy)
+{
+    const float qx = std::clamp(px, w.x, w.x + w.w);
+    const float qy = std::clamp(py, w.y, w.y + w.h);
+    const float dx = px - qx, dy = py - qy;
+    const float d2 = dx*dx + dy*dy;
+
+    if (d2 > 0.f) {
+        const float d = std::sqrt(d2);
+        gx = dx / d; gy = dy / d;
+        return d;
+    }
+
+    // inside: nearest side
+    const float dl = px - w.x, dr = w.x + w.w - px;
+    const float db = py - w.y, dt = w.y + w.h - py;
+    float m = dl; gx = -1.f; gy = 0.f;
+    if (dr < m) { m = dr; gx = +1.f; gy = 0.f; }
+    if (db < m) { m = db; gx = 0.f;  gy = -1.f; }
+    if (dt < m) { m = dt; gx = 0.f;  gy = +1.f; }
+    return -m;
+}
+
+void WallSDF::Clear()
+{
+    m_Nx = m_Ny = 0;
+    m_Nodes.clear();
+}
+
+void WallSDF::Build(const std::vector<MazeWall>& walls, float cellSize, float pad)
+{
+    Clear();
+    if (walls.empty() || cellSize <= 0.f) return;
+
+    m_Cell    = cellSize;
+    m_InvCell = 1.f / m_Cell;
+    // far enough for any circle we test, a few cells either way
+    m_MaxDist = std::max(64.f, 4.f * m_Cell);
+
+    float minX = walls[0].x, minY = walls[0].y;
+    float maxX = walls[0].x + walls[0].w, maxY = walls[0].y + walls[0].h;
+    for (const auto& w : walls) {
+        minX = std::min(minX, w.x);       minY = std::min(minY, w.y);
+        maxX = std::max(maxX, w.x + w.w); maxY = std::max(maxY, w.y + w.h);
+    }
+    m_OriginX = minX - pad;
+    m_OriginY = minY - pad;
+    m_Nx = std::max(2, int(std::ceil((maxX - minX + 2.f * pad) * m_InvCell)) + 1);
+    m_Ny = std::max(2, int(std::ceil((maxY - minY + 2.f * pad) * m_InvCell)) + 1);
+    m_Nodes.assign(size_t(m_Nx) * size_t(m_Ny) * 3, 0.f);
+
+    // Stamp each wall into the nodes within m_MaxDist of it, keeping the
+    // nearest per node; nodes no wall reaches stay at the clamp. Walls go in
+    // index order with a strict min, so ties resolve as a per-node scan would.
+    for (size_t k = 0; k < m_Nodes.size(); k += 3) m_Nodes[k] = m_MaxDist;
+
+    for (const MazeWall& w : walls) {
+        const int i0 = std::max(0, int(std::ceil((w.x - m_MaxDist - m_OriginX) * m_InvCell)));
+        const int j0 = std::max(0, int(std::ceil((w.y - m_MaxDist - m_OriginY) * m_InvCell)));
+        const int i1 = std::min(m_Nx - 1, int(std::floor((w.x + w.w + m_MaxDist - m_OriginX) * m_InvCell)));
+        const int j1 = std::min(m_Ny - 1, int(std::floor((w.y + w.h + m_MaxDist - m_OriginY) * m_InvCell)));
+
+        for (int j = j0; j <= j1; ++j) {
+            const float py = m_OriginY + j * m_Cell;
+            float* n = &m_Nodes[(size_t(j) * size_t(m_Nx) + size_t(i0)) * 3];
+            for (int i = i0; i <= i1; ++i, n += 3) {
+                float gx, gy;
+                const float d = RectSDF(w, m_OriginX + i * m_Cell, py, gx, gy);
+                if (d < n[0]) { n[0] = d; n[1] = gx; n[2] = gy; }
+            }
+        }
+    }
+}
+
+WallSDF::Layout WallSDF::GetLayout() const
+{
+    Layout l;
+    l.originX = m_OriginX; l.originY = m_OriginY;
+    l.cell = m_Cell;       l.maxDist = m_MaxDist;
+    l.nx = m_Nx;           l.ny = m_Ny;
+    return l;
+}
+
+bool WallSDF::Assign(const Layout& l, const float* nodes, size_t count)
+{
+    Clear();
+    if (l.nx < 2 || l.ny < 2 || l.cell <= 0.f) return false;
+    if (count != size_t(l.nx) * size_t(l.ny) * 3 || !nodes) return false;
+
+    m_OriginX = l.originX; m_OriginY = l.originY;
+    m_Cell    = l.cell;    m_InvCell = 1.f / l.cell;
+    m_MaxDist = l.maxDist;
+    m_Nx = l.nx;           m_Ny = l.ny;
+    m_Nodes.assign(nodes, nodes + count);
+    return true;
+}
+
+bool WallSDF::Locate(float x, float y, int& i, int& j, float& fx, float& fy) const
+{
+    if (m_Nodes.empty()) return false;
+    const float u = (x - m_OriginX) * m_InvCell;
+    const float v = (y - m_OriginY) * m_InvCell;
+    if (u < 0.f || v < 0.f || u > float(m_Nx - 1) || v > float(m_Ny - 1)) return false;
+
+    i = std::min(int(u), m_Nx - 2);
+    j = std::min(int(v), m_Ny - 2);
+    fx = u - float(i);
+    fy = v - float(j);
+    return true;
+}
+
+bool WallSDF::SampleDistance(float x, float y, float& d) const
+{
+    int i, j; float fx, fy;
+    if (!Locate(x, y, i, j, fx, fy)) return false;
+
+    const size_t row = size_t(m_Nx) * 3;
+    const float* n00 = &m_Nodes[(size_t(j) * size_t(m_Nx) + size_t(i)) * 3];
+    const float* n10 = n00 + 3;
+    const float* n01 = n00 + row;
+    const float* n11 = n01 + 3;
+
+    const float w00 = (1.f - fx) * (1.f - fy), w10 = fx * (1.f - fy);
+    const float w01 = (1.f - fx) * fy,         w11 = fx * fy;
+    d = w00 * n00[0] + w10 * n10[0] + w01 * n01[0] + w11 * n11[0];
+    return true;
+}
+
+bool WallSDF::Sample(float x, float y, float& d, float& gx, float& gy) const
+{
+    int i, j; float fx, fy;
+    if (!Locate(x, y, i, j, fx, fy)) return false;
+
+    const size_t row = size_t(m_Nx) * 3;
+    const float* n00 = &m_Nodes[(size_t(j) * size_t(m_Nx) + size_t(i)) * 3];
+    const float* n10 = n00 + 3;
+    const float* n01 = n00 + row;
+    const float* n11 = n01 + 3;
+
+    const float w00 = (1.f - fx) * (1.f - fy), w10 = fx * (1.f - fy);
+    const float w01 = (1.f - fx) * fy,         w11 = fx * fy;
+    d  = w00 * n00[0] + w10 * n10[0] + w01 * n01[0] + w11 * n11[0];
+    gx = w00 * n00[1] + w10 * n10[1] + w01 * n01[1] + w11 * n11[1];
+    gy = w00 * n00[2] + w10 * n10[2] + w01 * n01[2] + w11 * n11[2];
+
+    const float len = std::sqrt(gx*gx + gy*gy);
+    if (len > 1e-6f) { gx /= len; gy /= len; }
+    else { gx = 0.f; gy = 0.f; }
+    return true;
+}
+
+} // namespace gameplay
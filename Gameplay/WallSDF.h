@@ -0,0 +1,52 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+namespace gameplay {
+
+    struct MazeWall;
+
+    // Baked signed distance to the maze walls (negative inside a wall) plus
+    // its gradient, on a regular node grid sampled bilinearly. Distances
+    // further than the bake range are stored clamped, so every sample is a
+    // lower bound of the true distance away from the walls and exact near
+    // them; inside overlapping walls the depth is approximate.
+    class WallSDF {
+    public:
+        // pad grows the baked area past the walls
+        void Build(const std::vector<MazeWall>& walls, float cellSize, float pad = 32.f);
+        void Clear();
+
+        bool  Empty() const { return m_Nodes.empty(); }
+        float Cell() const { return m_Cell; }
+        float MaxDistance() const { return m_MaxDist; }
+
+        // raw bake, for storing it and restoring it later without rebuilding
+        struct Layout {
+            float originX = 0.f, originY = 0.f;
+            float cell = 8.f, maxDist = 64.f;
+            int   nx = 0, ny = 0;
+        };
+        Layout GetLayout() const;
+        const std::vector<float>& Nodes() const { return m_Nodes; }
+        // false (and cleared) when 'count' doesn't match the layout
+        bool Assign(const Layout& layout, const float* nodes, size_t count);
+
+        // distance and normalized gradient (pointing away from the walls);
+        // false outside the baked area
+        bool Sample(float x, float y, float& d, float& gx, float& gy) const;
+        bool SampleDistance(float x, float y, float& d) const;
+
+    private:
+        bool Locate(float x, float y, int& i, int& j, float& fx, float& fy) const;
+
+        float m_OriginX{0.f}, m_OriginY{0.f};
+        float m_Cell{8.f}, m_InvCell{1.f / 8.f};
+        float m_MaxDist{64.f};
+        int   m_Nx{0}, m_Ny{0};
+
+        // interleaved d, gx, gy per node, row-major
+        std::vector<float> m_Nodes;
+    };
+
+} // namespace gameplay
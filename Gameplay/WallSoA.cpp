@@ -0,0 +1,125 @@
+#include "Gameplay/WallSoA.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+#if defined(__AVX2__)
+    #include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define GEOA_WALLSOA_SSE2 1
+#endif
+
+#include "Gameplay/Maze.h"
+
+namespace gameplay {
+
+// padding box: far enough that its squared distance can never pass a test,
+// small enough that the square stays finite
+static constexpr float kFar = 1e18f;
+
+void WallSoA::Clear()
+{
+    minX.clear(); minY.clear();
+    maxX.clear(); maxY.clear();
+    count = 0;
+}
+
+void WallSoA::Build(const std::vector<MazeWall>& walls)
+{
+    count = walls.size();
+    const size_t padded = (count + kLanes - 1) / kLanes * kLanes;
+    minX.assign(padded, kFar); minY.assign(padded, kFar);
+    maxX.assign(padded, kFar); maxY.assign(padded, kFar);
+
+    for (size_t i = 0; i < count; ++i) {
+        const MazeWall& w = walls[i];
+        minX[i] = w.x;       minY[i] = w.y;
+        maxX[i] = w.x + w.w; maxY[i] = w.y + w.h;
+    }
+}
+
+// Calls hit(i) for every wall whose closest point is within sqrt(r2),
+// in ascending order. Branch-free per lane; only the hit mask is scanned.
+template <class Hit>
+static void Scan(const WallSoA& s, float cx, float cy, float r2, Hit&& hit)
+{
+    const size_t n = s.minX.size();
+    const float* x0 = s.minX.data(); const float* y0 = s.minY.data();
+    const float* x1 = s.maxX.data(); const float* y1 = s.maxY.data();
+
+#if defined(__AVX2__)
+    const __m256 vcx = _mm256_set1_ps(cx), vcy = _mm256_set1_ps(cy);
+    const __m256 vr2 = _mm256_set1_ps(r2);
+    for (size_t i = 0; i < n; i += 8) {
+        const __m256 qx = _mm256_min_ps(_mm256_max_ps(vcx, _mm256_loadu_ps(x0 + i)), _mm256_loadu_ps(x1 + i));
+        const __m256 qy = _mm256_min_ps(_mm256_max_ps(vcy, _mm256_loadu_ps(y0 + i)), _mm256_loadu_ps(y1 + i));
+        const __m256 dx = _mm256_sub_ps(vcx, qx);
+        const __m256 dy = _mm256_sub_ps(vcy, qy);
+        const __m256 d2 = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+        unsigned m = unsigned(_mm256_movemask_ps(_mm256_cmp_ps(d2, vr2, _CMP_LE_OQ)));
+        while (m) { hit(uint32_t(i + std::countr_zero(m))); m &= m - 1; }
+    }
+#elif defined(GEOA_WALLSOA_SSE2)
+    const __m128 vcx = _mm_set1_ps(cx), vcy = _mm_set1_ps(cy);
+    const __m128 vr2 = _mm_set1_ps(r2);
+    for (size_t i = 0; i < n; i += 4) {
+        const __m128 qx = _mm_min_ps(_mm_max_ps(vcx, _mm_loadu_ps(x0 + i)), _mm_loadu_ps(x1 + i));
+        const __m128 qy = _mm_min_ps(_mm_max_ps(vcy, _mm_loadu_ps(y0 + i)), _mm_loadu_ps(y1 + i));
+        const __m128 dx = _mm_sub_ps(vcx, qx);
+        const __m128 dy = _mm_sub_ps(vcy, qy);
+        const __m128 d2 = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+        unsigned m = unsigned(_mm_movemask_ps(_mm_cmple_ps(d2, vr2)));
+        while (m) { hit(uint32_t(i + std::countr_zero(m))); m &= m - 1; }
+    }
+#else
+    for (size_t i = 0; i < n; ++i) {
+        const float dx = cx - std::min(std::max(cx, x0[i]), x1[i]);
+        const float dy = cy - std::min(std::max(cy, y0[i]), y1[i]);
+        if (dx*dx + dy*dy <= r2) hit(uint32_t(i));
+    }
+#endif
+}
+
+void WallSoA::Within(float cx, float cy, float r, std::vector<uint32_t>& out) const
+{
+    out.clear();
+    if (r < 0.f) return;
+    Scan(*this, cx, cy, r * r, [&](uint32_t i) { out.push_back(i); });
+}
+
+void WallSoA::CircleContacts(float cx, float cy, float r, std::vector<WallContact>& out) const
+{
+    out.clear();
+    if (r < 0.f) return;
+    Scan(*this, cx, cy, r * r, [&](uint32_t i) { out.push_back(Contact(i, cx, cy, r)); });
+}
+
+WallContact WallSoA::Contact(uint32_t i, float cx, float cy, float r) const
+{
+    WallContact c{ i, 0.f, 0.f, 0.f };
+
+    const float qx = std::clamp(cx, minX[i], maxX[i]);
+    const float qy = std::clamp(cy, minY[i], maxY[i]);
+    const float dx = cx - qx, dy = cy - qy;
+    const float d2 = dx*dx + dy*dy;
+
+    if (d2 > 0.f) {
+        const float d = std::sqrt(d2);
+        c.nx = dx / d; c.ny = dy / d;
+        c.depth = r - d;
+        return c;
+    }
+
+    // centre inside: out through the nearest side
+    const float dl = cx - minX[i], dr = maxX[i] - cx;
+    const float db = cy - minY[i], dt = maxY[i] - cy;
+    float m = dl; c.nx = -1.f;
+    if (dr < m) { m = dr; c.nx = +1.f; c.ny = 0.f; }
+    if (db < m) { m = db; c.nx = 0.f;  c.ny = -1.f; }
+    if (dt < m) { m = dt; c.nx = 0.f;  c.ny = +1.f; }
+    c.depth = r + m;
+    return c;
+}
+
+} // namespace gameplay
@@ -0,0 +1,41 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace gameplay {
+
+    struct MazeWall;
+
+    // one circle vs one wall; the normal points from the wall to the centre
+    struct WallContact {
+        uint32_t wall;
+        float    nx, ny;
+        float    depth;   // push along n that clears the circle
+    };
+
+    // Structure-of-arrays copy of a wall list (bounds, not x/y/w/h), padded
+    // to a multiple of kLanes with boxes far outside any level so the kernel
+    // never needs a tail loop. The circle tests run 8 walls at a time with
+    // AVX2, 4 with SSE2, and fall back to plain scalar code elsewhere.
+    struct WallSoA {
+        static constexpr size_t kLanes = 8;
+
+        std::vector<float> minX, minY, maxX, maxY;
+        size_t count = 0;   // real walls, the rest is padding
+
+        void Build(const std::vector<MazeWall>& walls);
+        void Clear();
+        bool Empty() const { return count == 0; }
+
+        // indices (ascending) of walls within r of (cx,cy)
+        void Within(float cx, float cy, float r, std::vector<uint32_t>& out) const;
+
+        // contacts (ascending wall index) of the circle with every wall it touches
+        void CircleContacts(float cx, float cy, float r, std::vector<WallContact>& out) const;
+
+        // contact with wall i, assuming the circle touches it
+        WallContact Contact(uint32_t i, float cx, float cy, float r) const;
+    };
+
+} // namespace gameplay
@@ -0,0 +1,297 @@
+#include "Gameplay/WorldChunks.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+#include "Gameplay/Broadphase.h"
+#include "Gameplay/CollisionSystemMaze.h"
+#include "Gameplay/GeoMotors.h"
+#include "Gameplay/JobSystem.h"
+#include "Gameplay/SeedMix.h"
+
+namespace gameplay {
+
+void ChunkManager::Reset(const WorldParams& params)
+{
+    m_Params = params;
+    m_Params.tileCols     = std::max(2, m_Params.tileCols);
+    m_Params.tileRows     = std::max(2, m_Params.tileRows);
+    m_Params.poolCapacity = std::max(1, m_Params.poolCapacity);
+
+    m_Frame = 0;
+    m_Generated = 0;
+    m_Pool.clear();
+    m_Pool.reserve(size_t(m_Params.poolCapacity));
+    m_Slots.clear();
+    m_Active.clear();
+    m_Picked.clear();
+}
+
+ThreeBlade ChunkManager::SpawnPoint() const
+{
+    return ThreeBlade(0.5f * m_Params.cellSize, 0.5f * m_Params.cellSize, 0.f);
+}
+
+void ChunkManager::TileAt(float x, float y, int32_t& tx, int32_t& ty) const
+{
+    tx = int32_t(std::floor(x / TileWidth()));
+    ty = int32_t(std::floor(y / TileHeight()));
+}
+
+int ChunkManager::Find(int32_t tx, int32_t ty) const
+{
+    auto it = m_Slots.find(Key(tx, ty));
+    return it == m_Slots.end() ? -1 : it->second;
+}
+
+int ChunkManager::AcquireSlot()
+{
+    if (m_Pool.size() < size_t(m_Params.poolCapacity)) {
+        m_Pool.emplace_back();
+        return int(m_Pool.size()) - 1;
+    }
+
+    // least recently active tile that is not in use this frame
+    int victim = -1;
+    for (int i = 0; i < int(m_Pool.size()); ++i) {
+        if (m_Pool[i].lastUsed == m_Frame) continue;
+        if (victim < 0 || m_Pool[i].lastUsed < m_Pool[victim].lastUsed) victim = i;
+    }
+
+    if (victim < 0) {
+        // the view alone needs more tiles than the pool holds
+        m_Pool.emplace_back();
+        return int(m_Pool.size()) - 1;
+    }
+
+    m_Slots.erase(Key(m_Pool[victim].tx, m_Pool[victim].ty));
+    return victim;
+}
+
+void ChunkManager::Generate(WorldChunk& c, int32_t tx, int32_t ty)
+{
+    const WorldParams& p = m_Params;
+    c.tx = tx; c.ty = ty;
+    c.minX = tx * TileWidth();   c.minY = ty * TileHeight();
+    c.maxX = c.minX + TileWidth(); c.maxY = c.minY + TileHeight();
+
+    MazeGenerator::TileParams tp;
+    tp.cols = p.tileCols;  tp.rows = p.tileRows;
+    tp.cellW = p.cellSize; tp.cellH = p.cellSize;
+    tp.wallThickness = p.wallThickness;
+    tp.seed = p.seed;
+
+    // a fresh maze object: snapshots may still hold the previous one
+    auto maze = std::make_shared<Maze>();
+    MazeGenerator::GenerateTile(*maze, tp, tx, ty);
+    c.maze = std::move(maze);
+
+    // content draws from its own stream so it doesn't depend on the walls
+    std::mt19937 rng(uint32_t(SplitMix64(SplitMix64(p.seed) ^ Key(tx, ty))));
+    std::uniform_int_distribution<int> cellX(0, p.tileCols - 1);
+    std::uniform_int_distribution<int> cellY(0, p.tileRows - 1);
+
+    // cell centres are always clear of the walls
+    auto cellCentre = [&](int x, int y) {
+        return ThreeBlade(c.minX + (x + 0.5f) * p.cellSize, c.minY + (y + 0.5f) * p.cellSize, 0.f);
+    };
+    auto randomCell = [&]() {
+        int x, y;
+        do { x = cellX(rng); y = cellY(rng); }
+        while (tx == 0 && ty == 0 && x == 0 && y == 0);   // keep the spawn clear
+        return cellCentre(x, y);
+    };
+
+    c.pillars.clear();
+    const int nPillars = std::uniform_int_distribution<int>(0, std::max(0, p.maxPillarsPerTile))(rng);
+    for (int i = 0; i < nPillars; ++i) c.pillars.push_back(randomCell());
+
+    c.movers.clear();
+    c.moverPending = 0.f;
+    const int nMovers = std::uniform_int_distribution<int>(0, std::max(0, p.maxMoversPerTile))(rng);
+    std::uniform_real_distribution<float> angle(0.f, 6.2831853f);
+    std::uniform_real_distribution<float> speed(40.f, 100.f);
+    std::uniform_real_distribution<float> omega(-1.5f, 1.5f);
+    std::uniform_real_distribution<float> radius(0.5f * p.cellSize, 1.5f * p.cellSize);
+    for (int i = 0; i < nMovers; ++i) {
+        const ThreeBlade at = randomCell();
+        const float a = angle(rng);
+        if (rng() & 1u) {
+            const float R = radius(rng);
+            Motor T = GeoMotors::MakeTranslator(R * std::cos(a), R * std::sin(a));
+            c.movers.push_back(MovablePillar::MakeOrbit(at, GeoMotors::Apply(at, T), omega(rng), 240.f));
+        } else {
+            const float s = speed(rng);
+            c.movers.push_back(MovablePillar::MakeLinear(at, s * std::cos(a), s * std::sin(a), 240.f));
+        }
+    }
+
+    c.collectibles.clear();
+    int lo = p.collectiblesMin, hi = p.collectiblesMax;
+    if (lo > hi) std::swap(lo, hi);
+    const int nCollect = std::uniform_int_distribution<int>(lo, hi)(rng);
+    for (int i = 0; i < nCollect; ++i) c.collectibles.push_back(randomCell());
+
+    c.collected.assign(c.collectibles.size(), 0);
+    for (int i = 0; i < int(c.collectibles.size()); ++i)
+        if (m_Picked.count({ tx, ty, i })) c.collected[i] = 1;
+
+    ++m_Generated;
+}
+
+int ChunkManager::Update(float viewMinX, float viewMinY, float viewMaxX, float viewMaxY)
+{
+    ++m_Frame;
+    m_Active.clear();
+
+    int32_t tx0, ty0, tx1, ty1;
+    TileAt(viewMinX, viewMinY, tx0, ty0);
+    TileAt(viewMaxX, viewMaxY, tx1, ty1);
+    m_ViewTx0 = tx0; m_ViewTy0 = ty0; m_ViewTx1 = tx1; m_ViewTy1 = ty1;
+    tx0 -= m_Params.activeMargin; ty0 -= m_Params.activeMargin;
+    tx1 += m_Params.activeMargin; ty1 += m_Params.activeMargin;
+
+    // mark what is already resident first so eviction never picks it
+    for (int32_t ty = ty0; ty <= ty1; ++ty)
+        for (int32_t tx = tx0; tx <= tx1; ++tx)
+            if (int s = Find(tx, ty); s >= 0) m_Pool[s].lastUsed = m_Frame;
+
+    int generated = 0;
+    for (int32_t ty = ty0; ty <= ty1; ++ty) {
+        for (int32_t tx = tx0; tx <= tx1; ++tx) {
+            int s = Find(tx, ty);
+            if (s < 0) {
+                s = AcquireSlot();
+                Generate(m_Pool[s], tx, ty);
+                m_Slots[Key(tx, ty)] = s;
+                ++generated;
+            }
+            m_Pool[s].lastUsed = m_Frame;
+            m_Active.push_back(s);
+        }
+    }
+    return generated;
+}
+
+void ChunkManager::StepMovers(float dt, float bounceLoss, JobSystem* jobs)
+{
+    auto stepRange = [&](size_t b, size_t e) {
+        for (size_t i = b; i < e; ++i) {
+            WorldChunk& c = m_Pool[size_t(m_Active[i])];
+            if (c.movers.empty()) continue;
+
+            c.moverPending += dt;
+            const bool inView = c.tx >= m_ViewTx0 && c.tx <= m_ViewTx1 &&
+                                c.ty >= m_ViewTy0 && c.ty <= m_ViewTy1;
+            const int interval = std::max(1, m_Params.marginStepInterval);
+            bool due = inView || (m_Frame + uint64_t(uint32_t(c.tx + c.ty))) % uint64_t(interval) == 0;
+            if (!due) {
+                // step early rather than let the skipped time carry a mover through a wall
+                float fastest = 0.f;
+                for (const auto& mp : c.movers) {
+                    float ux, uy;
+                    mp.Velocity(ux, uy);
+                    fastest = std::max(fastest, ux * ux + uy * uy);
+                }
+                due = std::sqrt(fastest) * (c.moverPending + dt) > m_Params.marginMaxTravel;
+            }
+            if (!due) continue;
+
+            const float h = c.moverPending;
+            c.moverPending = 0.f;
+            for (auto& mp : c.movers) {
+                mp.Step(h, c.minX, c.minY, c.maxX, c.maxY, bounceLoss);
+                if (c.maze) mp.CollideWalls(*c.maze, bounceLoss);
+            }
+            // movers never leave their tile, so pairs are found per chunk
+            if (c.movers.size() > 1) {
+                thread_local SweepAndPrune sap;
+                MovablePillar::CollidePillars(c.movers, sap, bounceLoss, c.maze.get());
+            }
+        }
+    };
+
+    if (jobs && jobs->WorkerCount() > 0) jobs->ParallelFor(m_Active.size(), 4, stepRange);
+    else stepRange(0, m_Active.size());
+}
+
+void ChunkManager::GatherPillars(std::vector<std::pair<ThreeBlade, PillarType>>& out) const
+{
+    out.clear();
+    for (int s : m_Active)
+        for (const auto& C : m_Pool[s].pillars) out.emplace_back(C, PillarType::Normal);
+    for (int s : m_Active) {
+        for (const auto& mp : m_Pool[s].movers) {
+            out.emplace_back(mp.C, mp.mode == MovablePillar::Mode::Linear ? PillarType::Linear
+                                                                          : PillarType::Movable);
+        }
+    }
+}
+
+void ChunkManager::GatherCollectibles(std::vector<ThreeBlade>& out, std::vector<char>& collected) const
+{
+    out.clear();
+    collected.clear();
+    for (int s : m_Active) {
+        out.insert(out.end(), m_Pool[s].collectibles.begin(), m_Pool[s].collectibles.end());
+        collected.insert(collected.end(), m_Pool[s].collected.begin(), m_Pool[s].collected.end());
+    }
+}
+
+void ChunkManager::Resolve(ThreeBlade& X, float& vx, float& vy, float radius, float bounceLoss) const
+{
+    // tiles own their north/east edges, so look one tile further on each side
+    const float reach = radius + m_Params.wallThickness;
+    int32_t tx0, ty0, tx1, ty1;
+    TileAt(X[0] - reach, X[1] - reach, tx0, ty0);
+    TileAt(X[0] + reach, X[1] + reach, tx1, ty1);
+
+    for (int32_t ty = ty0; ty <= ty1; ++ty) {
+        for (int32_t tx = tx0; tx <= tx1; ++tx) {
+            const int s = Find(tx, ty);
+            if (s >= 0) CollisionSystemMaze::Resolve(*m_Pool[s].maze, X, vx, vy, radius, bounceLoss);
+        }
+    }
+}
+
+int ChunkManager::SweepMove(ThreeBlade& X, float dx, float dy, float& vx, float& vy,
+                            float radius, float bounceLoss) const
+{
+    // a bounce can send the rest of the move back, so take the box around
+    // everything the move could reach
+    const float reach = std::sqrt(dx*dx + dy*dy) + radius + m_Params.wallThickness;
+    const float x0 = X[0] - reach, x1 = X[0] + reach;
+    const float y0 = X[1] - reach, y1 = X[1] + reach;
+
+    thread_local std::vector<const Maze*> s_Mazes;
+    s_Mazes.clear();
+    for (int s : m_Active) {
+        const WorldChunk& c = m_Pool[s];
+        if (c.maxX < x0 || c.minX > x1 || c.maxY < y0 || c.minY > y1) continue;
+        s_Mazes.push_back(c.maze.get());
+    }
+    return CollisionSystemMaze::SweepMove(s_Mazes.data(), s_Mazes.size(),
+                                          X, dx, dy, vx, vy, radius, bounceLoss);
+}
+
+int ChunkManager::CheckPickups(const ThreeBlade& X, float radius)
+{
+    int picked = 0;
+    const float r = radius + m_Params.collectibleRadius;
+    for (int s : m_Active) {
+        WorldChunk& c = m_Pool[s];
+        if (X[0] < c.minX - r || X[0] > c.maxX + r || X[1] < c.minY - r || X[1] > c.maxY + r) continue;
+        for (int i = 0; i < int(c.collectibles.size()); ++i) {
+            if (c.collected[i]) continue;
+            TwoBlade L = X & c.collectibles[i];
+            if (L.Norm() <= r) {
+                c.collected[i] = 1;
+                m_Picked.insert({ c.tx, c.ty, i });
+                ++picked;
+            }
+        }
+    }
+    return picked;
+}
+
+} // namespace gameplay
@@ -0,0 +1,127 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "../FlyFish.h"
+#include "Gameplay/Maze.h"
+#include "Gameplay/MazeGenerator.h"
+#include "Gameplay/MovablePillar.h"
+#include "Gameplay/PillarRenderer.h"
+
+namespace gameplay {
+
+    class JobSystem;
+
+    struct WorldParams {
+        // tile layout (a tile is tileCols x tileRows maze cells)
+        int   tileCols = 8, tileRows = 8;
+        float cellSize = 80.f;
+        float wallThickness = 16.f;
+
+        // content per tile
+        int   maxPillarsPerTile = 1;
+        int   maxMoversPerTile  = 1;
+        int   collectiblesMin = 1, collectiblesMax = 3;
+        float collectibleRadius = 10.f;
+
+        // tiles beyond the view that are still simulated; their movers step
+        // every marginStepInterval frames, or sooner before one would move
+        // more than marginMaxTravel in a step
+        int   activeMargin = 1;
+        int   marginStepInterval = 4;
+        float marginMaxTravel = 12.f;
+        // resident tiles, active ones plus recently left ones kept for reuse
+        int   poolCapacity = 48;
+
+        uint32_t seed = 1;
+    };
+
+    // One fixed-size tile of the endless world. Everything in it is derived
+    // from (seed, tx, ty), so an evicted tile comes back identical.
+    struct WorldChunk {
+        int32_t  tx = 0, ty = 0;
+        uint64_t lastUsed = 0;
+        float minX = 0.f, minY = 0.f, maxX = 0.f, maxY = 0.f;
+
+        // immutable once generated, shared with render snapshots
+        std::shared_ptr<const Maze> maze;
+
+        std::vector<ThreeBlade>    pillars;   // static
+        std::vector<MovablePillar> movers;    // kept inside the tile bounds
+        float moverPending = 0.f;             // time the movers skipped (margin tiles)
+        std::vector<ThreeBlade>    collectibles;
+        std::vector<char>          collected;
+    };
+
+    // Loads the tiles around a camera, keeps them in a bounded LRU pool and
+    // exposes only the active ones to the simulation and the renderer, so
+    // frame cost follows what is near the view rather than the world size.
+    class ChunkManager {
+    public:
+        void Reset(const WorldParams& params);
+
+        // Activates (generating if needed) every tile overlapping the view
+        // grown by activeMargin tiles. Returns how many tiles were generated.
+        int Update(float viewMinX, float viewMinY, float viewMaxX, float viewMaxY);
+
+        const std::vector<int>& Active() const { return m_Active; }
+        const WorldChunk& Chunk(int slot) const { return m_Pool[size_t(slot)]; }
+
+        float TileWidth()  const { return m_Params.tileCols * m_Params.cellSize; }
+        float TileHeight() const { return m_Params.tileRows * m_Params.cellSize; }
+        const WorldParams& Params() const { return m_Params; }
+
+        size_t ResidentCount() const { return m_Pool.size(); }
+        uint64_t GeneratedCount() const { return m_Generated; }
+
+        // centre of the first cell of tile (0,0)
+        ThreeBlade SpawnPoint() const;
+
+        // --- active tiles only ---
+        // tiles in the view step every frame, margin tiles at a lower rate
+        void StepMovers(float dt, float bounceLoss, JobSystem* jobs = nullptr);
+
+        // static pillars of every active tile first, then their movers
+        void GatherPillars(std::vector<std::pair<ThreeBlade, PillarType>>& out) const;
+
+        void GatherCollectibles(std::vector<ThreeBlade>& out, std::vector<char>& collected) const;
+
+        // walls of the tiles the circle can touch
+        void Resolve(ThreeBlade& X, float& vx, float& vy, float radius, float bounceLoss) const;
+
+        // CollisionSystemMaze::SweepMove over the active tiles along the move
+        int SweepMove(ThreeBlade& X, float dx, float dy, float& vx, float& vy,
+                      float radius, float bounceLoss) const;
+
+        // marks touched collectibles, returns how many were picked up
+        int CheckPickups(const ThreeBlade& X, float radius);
+
+    private:
+        static uint64_t Key(int32_t tx, int32_t ty) {
+            return (uint64_t(uint32_t(tx)) << 32) | uint32_t(ty);
+        }
+
+        int  Find(int32_t tx, int32_t ty) const;
+        int  AcquireSlot();
+        void Generate(WorldChunk& c, int32_t tx, int32_t ty);
+        void TileAt(float x, float y, int32_t& tx, int32_t& ty) const;
+
+        WorldParams m_Params;
+        uint64_t    m_Frame{0};
+        uint64_t    m_Generated{0};
+
+        std::vector<WorldChunk>           m_Pool;
+        std::unordered_map<uint64_t, int> m_Slots;    // tile key -> pool slot
+        std::vector<int>                  m_Active;
+        int32_t m_ViewTx0{0}, m_ViewTy0{0}, m_ViewTx1{-1}, m_ViewTy1{-1};   // tiles under the view
+
+        // pickups survive eviction: (tx, ty, index)
+        std::set<std::tuple<int32_t, int32_t, int>> m_Picked;
+    };
+
+} // namespace gameplay
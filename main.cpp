@@ -1,5 +1,7 @@
 #include "SDL.h"
 
+#include <cstdint>
+#include <cstdlib>
 #include <ctime>
 #include "Game.h"
 
@@ -8,7 +10,9 @@ int main(int argv, char** args)
 	srand(static_cast<unsigned int>(time(nullptr)));
 
 	Window window{ "GEOA Project Demo", 1280.f , 720.f };
-	Game pGame{ window };
+	// optional first argument: game seed, replays the same levels
+	uint32_t seed = argv > 1 ? static_cast<uint32_t>(std::strtoul(args[1], nullptr, 10)) : 0u;
+	Game pGame{ window, seed };
 	pGame.Run();
 
 	return 0;